@@ -41,7 +41,73 @@
 #include <ostream>
 #endif
 
-//TODO: shift operators
+#if defined(__GNUC__) || defined(__clang__)
+#define INTEGER_HPP_HAS_BUILTINS 1
+#else
+#define INTEGER_HPP_HAS_BUILTINS 0
+#endif
+
+// pdep/pext are not constexpr, so they are only used outside of
+// constant evaluation
+#define INTEGER_HPP_HAS_BMI2 0
+#if INTEGER_HPP_HAS_BUILTINS && defined(__BMI2__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#undef INTEGER_HPP_HAS_BMI2
+#define INTEGER_HPP_HAS_BMI2 1
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define INTEGER_HPP_HAS_INT128 1
+#else
+#define INTEGER_HPP_HAS_INT128 0
+#endif
+
+#ifndef __has_include
+#define INTEGER_HPP_HAS_VECTOR 0
+#else
+#if __has_include(<vector>)
+#define INTEGER_HPP_HAS_VECTOR 1
+#else
+#define INTEGER_HPP_HAS_VECTOR 0
+#endif
+#endif
+
+#if INTEGER_HPP_HAS_VECTOR
+#include <vector>
+#endif
+
+#ifndef __has_include
+#define INTEGER_HPP_HAS_CMATH 0
+#else
+#if __has_include(<cmath>)
+#define INTEGER_HPP_HAS_CMATH 1
+#else
+#define INTEGER_HPP_HAS_CMATH 0
+#endif
+#endif
+
+#if INTEGER_HPP_HAS_CMATH
+#include <cmath>
+#include <limits>
+#endif
+
+// opt-in, define as 1 for batch_modinv_parallel and <thread>
+#ifndef INTEGER_HPP_HAS_THREAD
+#define INTEGER_HPP_HAS_THREAD 0
+#endif
+
+#if INTEGER_HPP_HAS_THREAD && INTEGER_HPP_HAS_VECTOR
+#include <thread>
+#endif
+
+// opt-in, define as 1 so that multiply and divide look at the magnitude
+// of the operands and skip all-zero high halves. The results are the
+// same, small operands get faster and full-width ones pay for the checks
+#ifndef INTEGER_HPP_ADAPTIVE
+#define INTEGER_HPP_ADAPTIVE 0
+#endif
 
 // -std=c++14
 namespace JIO {
@@ -491,7 +557,11 @@ namespace JIO {
 
         template<typename T>
         constexpr inline int bitCount_n(T value) noexcept {
+#if INTEGER_HPP_HAS_BUILTINS && defined(__POPCNT__)
+            return __builtin_popcountll(p_i_native::native_int_type<sizeof (T), false > (value));
+#else
             return bitCount_h(p_i_native::native_int_type<sizeof (T), false > (value));
+#endif
         }
 
         template<typename T>
@@ -499,6 +569,26 @@ namespace JIO {
             return bitCount_n(npo2m1_n(value));
         }
 
+#if INTEGER_HPP_HAS_BUILTINS
+        // lzcnt/tzcnt (or bsr/bsf) instead of the popcount based fallback
+
+        template<typename T>
+        constexpr inline int numberOfLeadingZeros_n(T value) noexcept {
+            using UT = typename std::make_unsigned<T>::type;
+            constexpr int bits = sizeof (T) * p_i_native::min_native_bits;
+            constexpr int extra = sizeof (unsigned long long) *
+                    p_i_native::min_native_bits - bits;
+            return UT(value) ? __builtin_clzll((unsigned long long) UT(value)) - extra : bits;
+        }
+
+        template<typename T>
+        constexpr inline int numberOfTrailingZeros_n(T value) noexcept {
+            using UT = typename std::make_unsigned<T>::type;
+            constexpr int bits = sizeof (T) * p_i_native::min_native_bits;
+            return UT(value) ? __builtin_ctzll((unsigned long long) UT(value)) : bits;
+        }
+#else
+
         template<typename T>
         constexpr inline int numberOfLeadingZeros_n(T value) noexcept {
             return sizeof (T) * p_i_native::min_native_bits - logb2_n(value);
@@ -508,6 +598,114 @@ namespace JIO {
         constexpr inline int numberOfTrailingZeros_n(T value) noexcept {
             return bitCount_n((value & -value) - 1);
         }
+#endif
+
+        // position of the k-th (from 0) set bit, k < bitCount_n(value)
+        template<typename T>
+        constexpr inline int select_n(T value, int k) noexcept {
+            using UT = p_i_native::native_int_type<sizeof (T), false>;
+            UT tmp = value;
+#if INTEGER_HPP_HAS_BMI2
+            if (!__builtin_is_constant_evaluated() && sizeof (T) <= 8) {
+                return numberOfTrailingZeros_n(UT(_pdep_u64(1ULL << k, tmp)));
+            }
+#endif
+            int out = 0;
+            for (int c = 0; k >= (c = bitCount_n(UT(tmp & 0xff))); k -= c) {
+                tmp >>= 8;
+                out += 8;
+            }
+            for (; k > 0; k--) {
+                tmp &= tmp - 1;
+            }
+            return out + numberOfTrailingZeros_n(tmp);
+        }
+
+        template<typename T>
+        constexpr inline T compress_n(T value, T mask) noexcept {
+            using UT = p_i_native::native_int_type<sizeof (T), false>;
+#if INTEGER_HPP_HAS_BMI2
+            if (!__builtin_is_constant_evaluated() && sizeof (T) <= 8) {
+                return sizeof (T) <= 4 ? T(_pext_u32(UT(value), UT(mask))) :
+                        T(_pext_u64(UT(value), UT(mask)));
+            }
+#endif
+            UT out = 0;
+            int i = 0;
+            for (UT m = mask; m; m &= m - 1, i++) {
+                out |= UT(UT(UT(value) >> numberOfTrailingZeros_n(m)) & 1) << i;
+            }
+            return out;
+        }
+
+        template<typename T>
+        constexpr inline T expand_n(T value, T mask) noexcept {
+            using UT = p_i_native::native_int_type<sizeof (T), false>;
+#if INTEGER_HPP_HAS_BMI2
+            if (!__builtin_is_constant_evaluated() && sizeof (T) <= 8) {
+                return sizeof (T) <= 4 ? T(_pdep_u32(UT(value), UT(mask))) :
+                        T(_pdep_u64(UT(value), UT(mask)));
+            }
+#endif
+            UT out = 0;
+            UT tmp = value;
+            for (UT m = mask; m; m &= m - 1, tmp >>= 1) {
+                out |= UT(tmp & 1) << numberOfTrailingZeros_n(m);
+            }
+            return out;
+        }
+
+        constexpr inline p_i_native::native_int_type<1, false >
+        reverseBytes_h(p_i_native::native_int_type<1, false > value) noexcept {
+            return value;
+        }
+
+#if INTEGER_HPP_HAS_BUILTINS
+
+        constexpr inline p_i_native::native_int_type<2, false >
+        reverseBytes_h(p_i_native::native_int_type<2, false > value) noexcept {
+            return __builtin_bswap16(value);
+        }
+
+        constexpr inline p_i_native::native_int_type<4, false >
+        reverseBytes_h(p_i_native::native_int_type<4, false > value) noexcept {
+            return __builtin_bswap32(value);
+        }
+
+        constexpr inline p_i_native::native_int_type<8, false >
+        reverseBytes_h(p_i_native::native_int_type<8, false > value) noexcept {
+            return __builtin_bswap64(value);
+        }
+#endif
+
+        template<typename T>
+        constexpr inline T reverseBytes_n(T value) noexcept {
+            using UT = p_i_native::native_int_type<sizeof (T), false>;
+#if INTEGER_HPP_HAS_BUILTINS
+            return T(reverseBytes_h(UT(value)));
+#else
+            UT tmp = value, out = 0;
+            for (size_t i = 0; i < sizeof (T); i++) {
+                out = UT(out << p_i_native::min_native_bits) | UT(tmp & 0xff);
+                tmp >>= p_i_native::min_native_bits;
+            }
+            return T(out);
+#endif
+        }
+
+        template<typename T>
+        constexpr inline T reverse_n(T value) noexcept {
+            // HD, Section 7-1
+            using UT = p_i_native::native_int_type<sizeof (T), false>;
+            constexpr UT m1 = UT(~UT(0)) / 3;
+            constexpr UT m2 = UT(~UT(0)) / 5;
+            constexpr UT m4 = UT(~UT(0)) / 17;
+            UT tmp = value;
+            tmp = UT(UT((tmp >> 1) & m1) | UT((tmp & m1) << 1));
+            tmp = UT(UT((tmp >> 2) & m2) | UT((tmp & m2) << 2));
+            tmp = UT(UT((tmp >> 4) & m4) | UT((tmp & m4) << 4));
+            return reverseBytes_n(T(tmp));
+        }
 
         constexpr inline size_t make_pow2(size_t i) noexcept {
             if (i == 0) {
@@ -534,6 +732,381 @@ namespace JIO {
         using array_ref = T(&)[length];
     }
 
+    namespace p_i_limbs {
+
+        typedef p_i_native::native_int_type<p_i_native::max_native_size, false> L;
+
+        constexpr static size_t limb_bits = p_i_native::max_native_bits;
+        constexpr static size_t limb_mask = limb_bits - 1;
+
+        template<size_t size>
+        constexpr inline size_t count() noexcept {
+            return size / p_i_native::max_native_size;
+        }
+
+        template<size_t size>
+        using array_t = p_i_seq::v_array_t<L, count<size>()>;
+
+#if INTEGER_HPP_HAS_INT128
+        __extension__ typedef unsigned __int128 LL;
+#endif
+
+        // a * b = high:low
+        constexpr inline L mul(L a, L b, L &high) noexcept {
+#if INTEGER_HPP_HAS_INT128
+            LL p = LL(a) * b;
+            high = L(p >> limb_bits);
+            return L(p);
+#else
+            constexpr size_t h = limb_bits / 2;
+            constexpr L m = (L(1) << h) - 1;
+            L a0 = a & m, a1 = a >> h, b0 = b & m, b1 = b >> h;
+            L p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+            L mid = (p00 >> h) + (p01 & m) + (p10 & m);
+            high = p11 + (p01 >> h) + (p10 >> h) + (mid >> h);
+            return (mid << h) | (p00 & m);
+#endif
+        }
+
+        // funnel shifts, 0 <= s < limb_bits, no branch for s == 0
+        constexpr inline L shld(L high, L low, size_t s) noexcept {
+            return (high << s) | ((low >> 1) >> (limb_mask - s));
+        }
+
+        constexpr inline L shrd(L high, L low, size_t s) noexcept {
+            return (low >> s) | ((high << 1) << (limb_mask - s));
+        }
+
+        // a += b mod B^m, b has k limbs
+        template<size_t m, size_t k>
+        constexpr inline void add_n(p_i_seq::v_array_t<L, m> &a,
+                const p_i_seq::v_array_t<L, k> &b) noexcept {
+            L carry = 0;
+            size_t i = 0;
+            for (; i < k && i < m; i++) {
+                L tmp = a[i] + carry;
+                carry = tmp < carry;
+                a[i] = tmp + b[i];
+                carry += a[i] < tmp;
+            }
+            for (; carry && i < m; i++) {
+                a[i] += carry;
+                carry = a[i] < carry;
+            }
+        }
+
+        // a -= b mod B^m
+        template<size_t m>
+        constexpr inline void sub_n(p_i_seq::v_array_t<L, m> &a,
+                const p_i_seq::v_array_t<L, m> &b) noexcept {
+            L borrow = 0;
+            for (size_t i = 0; i < m; i++) {
+                L tmp = a[i] - borrow;
+                borrow = tmp > a[i];
+                a[i] = tmp - b[i];
+                borrow += a[i] > tmp;
+            }
+        }
+
+        // acc += a * b mod B^m, the rows of the product are added
+        // without materializing it
+        template<size_t m, size_t n, size_t k>
+        constexpr inline void addmul_n(p_i_seq::v_array_t<L, m> &acc,
+                const p_i_seq::v_array_t<L, n> &a,
+                const p_i_seq::v_array_t<L, k> &b) noexcept {
+            for (size_t j = 0; j < k && j < m; j++) {
+#if INTEGER_HPP_ADAPTIVE
+                if (b[j] == 0) {
+                    continue;
+                }
+#endif
+                L carry = 0;
+                size_t i = 0;
+                for (; i < n && i + j < m; i++) {
+                    L high = 0;
+                    L low = mul(a[i], b[j], high);
+                    low += carry;
+                    high += low < carry;
+                    acc[i + j] += low;
+                    carry = high + (acc[i + j] < low);
+                }
+                for (i += j; carry && i < m; i++) {
+                    acc[i] += carry;
+                    carry = acc[i] < carry;
+                }
+            }
+        }
+
+        // index of the highest non-zero limb + 1, 0 for zero
+        template<size_t n>
+        constexpr inline size_t length(const p_i_seq::v_array_t<L, n> &a) noexcept {
+            size_t out = n;
+            while (out > 0 && a[out - 1] == 0) {
+                out--;
+            }
+            return out;
+        }
+
+        // a = a * x mod B^n
+        template<size_t n>
+        constexpr inline void mul_1(p_i_seq::v_array_t<L, n> &a, L x) noexcept {
+#if INTEGER_HPP_ADAPTIVE
+            const size_t top = length(a);
+#else
+            const size_t top = n;
+#endif
+            L carry = 0;
+            for (size_t i = 0; i < top; i++) {
+                L high = 0;
+                L low = mul(a[i], x, high);
+                low += carry;
+                carry = high + (low < carry);
+                a[i] = low;
+            }
+            if (top < n) {
+                a[top] = carry;
+            }
+        }
+
+        // a = a * b mod B^n, schoolbook over the k limbs of b. The limbs of
+        // a are consumed from the top, so the product is accumulated in place
+        template<size_t n, size_t k>
+        constexpr inline void mul_n(p_i_seq::v_array_t<L, n> &a,
+                const p_i_seq::v_array_t<L, k> &b) noexcept {
+            for (size_t j = n; j-- > 0;) {
+                L x = a[j];
+                a[j] = 0;
+#if INTEGER_HPP_ADAPTIVE
+                if (x == 0) {
+                    continue;
+                }
+#endif
+                L carry = 0;
+                for (size_t i = 0; i < k && i + j < n; i++) {
+                    L high = 0;
+                    L low = mul(x, b[i], high);
+                    low += carry;
+                    high += low < carry;
+                    a[i + j] += low;
+                    carry = high + (a[i + j] < low);
+                }
+                for (size_t i = j + k; carry && i < n; i++) {
+                    a[i] += carry;
+                    carry = a[i] < carry;
+                }
+            }
+        }
+
+        // Montgomery reduction, t = t / B^n mod m, minv = -1 / m mod B.
+        // For t < m * B^n the upper half of t is below 2m, the returned
+        // carry is its bit n * limb_bits
+        template<size_t n, size_t k>
+        constexpr inline L redc(p_i_seq::v_array_t<L, k> &t,
+                const p_i_seq::v_array_t<L, n> &m, L minv) noexcept {
+            static_assert(k == 2 * n, "wrong size of t");
+            // carry out of t[i + n], added with the next row
+            L top = 0;
+            for (size_t i = 0; i < n; i++) {
+                L u = t[i] * minv;
+                L carry = 0;
+                for (size_t j = 0; j < n; j++) {
+                    L high = 0;
+                    L low = mul(u, m[j], high);
+                    low += carry;
+                    high += low < carry;
+                    t[i + j] += low;
+                    carry = high + (t[i + j] < low);
+                }
+                L tmp = t[i + n] + carry;
+                L c = tmp < carry;
+                t[i + n] = tmp + top;
+                top = c + (t[i + n] < top);
+            }
+            return top;
+        }
+
+        // 1 / d mod B for an odd d, Newton's steps double the bits,
+        // d * d = 1 mod 8
+        constexpr inline L binvert(L d) noexcept {
+            L x = d;
+            for (size_t i = 3; i < limb_bits; i *= 2) {
+                x *= 2 - d * x;
+            }
+            return x;
+        }
+
+        // Hensel division from the low end, q = a / d mod B^n for an odd d,
+        // dinv = 1 / d mod B. a is destroyed, q is the exact quotient
+        // when d divides a
+        template<size_t n>
+        constexpr inline void bdiv(p_i_seq::v_array_t<L, n> &q,
+                p_i_seq::v_array_t<L, n> &a,
+                const p_i_seq::v_array_t<L, n> &d, L dinv) noexcept {
+            const size_t dn = length(d);
+            for (size_t i = 0; i < n; i++) {
+                L u = a[i] * dinv;
+                q[i] = u;
+                // a -= u * d * B^i, the limbs above n are dropped
+                L borrow = 0;
+                for (size_t j = 0; j < dn && i + j < n; j++) {
+                    L high = 0;
+                    L low = mul(u, d[j], high);
+                    low += borrow;
+                    high += low < borrow;
+                    L t = a[i + j];
+                    a[i + j] = t - low;
+                    borrow = high + (t < low);
+                }
+                for (size_t j = i + dn; borrow && j < n; j++) {
+                    L t = a[j];
+                    a[j] = t - borrow;
+                    borrow = t < borrow;
+                }
+            }
+        }
+
+        // a = a mod 2^k + c * (a >> k) until a < 2^k, k < n * limb_bits.
+        // For m = 2^k - c this keeps a modulo m, as 2^k = c (mod m)
+        template<size_t n>
+        constexpr inline void fold(p_i_seq::v_array_t<L, n> &a, size_t k, L c) noexcept {
+            const size_t q = k / limb_bits;
+            const size_t s = k & limb_mask;
+            for (size_t top = length(a); top > q + 1 || (top == q + 1 &&
+                    (a[q] >> s) != 0); top = length(a)) {
+                // the limbs of a >> k
+                const size_t hn = top - q;
+                p_i_seq::v_array_t<L, n> high{};
+                for (size_t i = 0; i < hn; i++) {
+                    high[i] = shrd(q + i + 1 < n ? a[q + i + 1] : 0, a[q + i], s);
+                }
+                a[q] &= (L(1) << s) - 1;
+                for (size_t i = q + 1; i < top; i++) {
+                    a[i] = 0;
+                }
+                L carry = 0;
+                for (size_t i = 0; i < hn; i++) {
+                    L h = 0;
+                    L low = mul(high[i], c, h);
+                    low += carry;
+                    h += low < carry;
+                    a[i] += low;
+                    carry = h + (a[i] < low);
+                }
+                for (size_t i = hn; carry && i < n; i++) {
+                    a[i] += carry;
+                    carry = a[i] < carry;
+                }
+            }
+        }
+
+        // floor((B^2 - 1) / d) - B, d is normalized (upper bit is set)
+        constexpr inline L reciprocal(L d) noexcept {
+#if INTEGER_HPP_HAS_INT128
+            return L(((LL(~d) << limb_bits) | L(~L(0))) / d);
+#else
+            // (B - 1 - d):(B - 1) / d, bit by bit
+            L r = ~d, q = 0;
+            for (size_t i = 0; i < limb_bits; i++) {
+                bool top = r >> limb_mask;
+                r = (r << 1) | 1;
+                q <<= 1;
+                if (top || r >= d) {
+                    r -= d;
+                    q |= 1;
+                }
+            }
+            return q;
+#endif
+        }
+
+        // (u1:u0) / d, u1 < d, d is normalized, v = reciprocal(d)
+        // Moller, Granlund "Improved division by invariant integers", Alg. 4
+        constexpr inline L div2by1(L u1, L u0, L d, L v, L &r) noexcept {
+            L q1 = 0;
+            L q0 = mul(v, u1, q1);
+            q0 += u0;
+            q1 += u1 + (q0 < u0);
+            q1++;
+            L tmp = u0 - q1 * d;
+            if (tmp > q0) {
+                q1--;
+                tmp += d;
+            }
+            if (tmp >= d) {
+                q1++;
+                tmp -= d;
+            }
+            r = tmp;
+            return q1;
+        }
+
+        // a = a / d, returns a % d, d != 0
+        template<size_t n>
+        constexpr inline L divrem_1(p_i_seq::v_array_t<L, n> &a, L d) noexcept {
+            const size_t s = p_i_utils::numberOfLeadingZeros_n(d);
+            d <<= s;
+            const L v = reciprocal(d);
+#if INTEGER_HPP_ADAPTIVE
+            // zero limbs on the top give zero quotient limbs
+            size_t top = length(a);
+            top += top == 0;
+#else
+            const size_t top = n;
+#endif
+            // the dividend is shifted by s on the fly
+            L r = shld(0, a[top - 1], s);
+            for (size_t i = top; i-- > 0;) {
+                L u0 = shld(a[i], i ? a[i - 1] : 0, s);
+                a[i] = div2by1(r, u0, d, v, r);
+            }
+            return r >> s;
+        }
+
+        // a <<= shift in place, 0 <= shift < n * limb_bits, n is a power of 2
+        template<size_t n>
+        constexpr inline void
+        shl(p_i_seq::v_array_t<L, n> &a, size_t shift) noexcept {
+            const size_t k = shift / limb_bits;
+            const size_t s = shift & limb_mask;
+            // from the top, only lower limbs are read
+            for (size_t i = n; i-- > 0;) {
+                // out of range limbs are read with a wrapped index and masked
+                L high = a[(i - k) & (n - 1)] & -L(i >= k);
+                L low = a[(i - k - 1) & (n - 1)] & -L(i >= k + 1);
+                a[i] = shld(high, low, s);
+            }
+        }
+
+        // 0 <= shift < n * limb_bits, n is a power of 2
+        template<size_t n>
+        constexpr inline p_i_seq::v_array_t<L, n>
+        rotl(const p_i_seq::v_array_t<L, n> &in, size_t shift) noexcept {
+            p_i_seq::v_array_t<L, n> out{};
+            const size_t k = shift / limb_bits;
+            const size_t s = shift & limb_mask;
+            for (size_t i = 0; i < n; i++) {
+                out[i] = shld(in[(i - k) & (n - 1)], in[(i - k - 1) & (n - 1)], s);
+            }
+            return out;
+        }
+
+        // a >>= shift in place, 0 <= shift < n * limb_bits, n is a power of 2
+        template<size_t n>
+        constexpr inline void
+        shr(p_i_seq::v_array_t<L, n> &a, size_t shift, L fill) noexcept {
+            const size_t k = shift / limb_bits;
+            const size_t s = shift & limb_mask;
+            // from the bottom, only upper limbs are read
+            for (size_t i = 0; i < n; i++) {
+                L lm = -L(i + k < n);
+                L hm = -L(i + k + 1 < n);
+                L low = (a[(i + k) & (n - 1)] & lm) | (fill & ~lm);
+                L high = (a[(i + k + 1) & (n - 1)] & hm) | (fill & ~hm);
+                a[i] = shrd(high, low, s);
+            }
+        }
+    }
+
     enum p_IType {
         illegal = 0,
         native,
@@ -714,9 +1287,10 @@ namespace JIO {
         template<size_t size2>
         struct divrem_h<size2, 1> {
 
+            // the smallest value by -1 wraps to itself, a
             constexpr inline static I div(const I &a, const I &b) noexcept {
                 if ((a.value == U(0x80)) && (b.value == U(-1))) {
-                    return I(0x80);
+                    return a;
                 }
                 return divrem_h<size2, 0>::div(a, b);
             }
@@ -734,7 +1308,7 @@ namespace JIO {
 
             constexpr inline static I div(const I &a, const I &b) noexcept {
                 if ((a.value == U(0x8000)) && (b.value == U(-1))) {
-                    return I(0x8000);
+                    return a;
                 }
                 return divrem_h<size2, 0>::div(a, b);
             }
@@ -752,7 +1326,7 @@ namespace JIO {
 
             constexpr inline static I div(const I &a, const I &b) noexcept {
                 if ((a.value == U(0x80000000L)) && (b.value == U(-1L))) {
-                    return I(0x80000000L);
+                    return a;
                 }
                 return divrem_h<size2, 0>::div(a, b);
             }
@@ -770,7 +1344,7 @@ namespace JIO {
 
             constexpr inline static I div(const I &a, const I &b) noexcept {
                 if ((a.value == U(0x8000000000000000LL)) && (b.value == U(-1LL))) {
-                    return I(0x8000000000000000LL);
+                    return a;
                 }
                 return divrem_h<size2, 0>::div(a, b);
             }
@@ -873,6 +1447,75 @@ namespace JIO {
             T::value = v ? (T::value | mask1) : (T::value & mask2);
         }
 
+        constexpr inline p_i_native::min_native_t
+        getByte(size_t index) const noexcept {
+            return T::value >> (index * p_i_native::min_native_bits);
+        }
+
+        constexpr inline void
+        setByte(size_t index, p_i_native::min_native_t v) noexcept {
+            const size_t shift = index * p_i_native::min_native_bits;
+            T::value = U((T::value & U(~(U(p_i_native::min_native_t(~0)) << shift))) |
+                    (U(v) << shift));
+        }
+
+        constexpr inline bool getBit(size_t index) const noexcept {
+            return (T::value >> index) & 1;
+        }
+
+        constexpr inline void setBit(size_t index, bool v) noexcept {
+            T::value = U((T::value & U(~(U(1) << index))) | (U(v) << index));
+        }
+
+        constexpr inline void flipBit(size_t index) noexcept {
+            T::value ^= U(U(1) << index);
+        }
+
+        template<typename F>
+        inline void forEachSetBit(F &&f, size_t offset) const {
+            for (U tmp = T::value; tmp; tmp &= tmp - 1) {
+                f(offset + p_i_utils::numberOfTrailingZeros_n(tmp));
+            }
+        }
+
+        constexpr inline size_t bitCount() const noexcept {
+            return p_i_utils::bitCount_n(T::value);
+        }
+
+        constexpr inline I rotateLeft(const M distance) const noexcept {
+            return I(U((T::value << (distance & T::shmask)) |
+                    (T::value >> ((0 - distance) & T::shmask))));
+        }
+
+        constexpr inline I reverseBytes() const noexcept {
+            return I(p_i_utils::reverseBytes_n(T::value));
+        }
+
+        constexpr inline I reverse() const noexcept {
+            return I(p_i_utils::reverse_n(T::value));
+        }
+
+        constexpr inline I compress(const I &mask) const noexcept {
+            return I(p_i_utils::compress_n(T::value, mask.value));
+        }
+
+        constexpr inline I expand(const I &mask) const noexcept {
+            return I(p_i_utils::expand_n(T::value, mask.value));
+        }
+
+        // 0 <= index <= bits, the shift is done on the unsigned value and
+        // index == 0 is apart, as a shift by bits is undefined
+        constexpr inline size_t rank(size_t index) const noexcept {
+            constexpr size_t bits = size * p_i_native::min_native_bits;
+            return index == 0 ? 0 :
+                    p_i_utils::bitCount_n(U(U(T::value) << (bits - index)));
+        }
+
+        constexpr inline size_t select(size_t k) const noexcept {
+            constexpr size_t bits = size * p_i_native::min_native_bits;
+            return k < bitCount() ? p_i_utils::select_n(T::value, k) : bits;
+        }
+
         constexpr inline static bool increment_overflow(I &value) noexcept {
             return T::increment_overflow(value);
         }
@@ -1035,17 +1678,26 @@ namespace JIO {
         constexpr static M shmask = half * 2 * 8 - 1;
         U low, high;
 
+        constexpr inline p_i_limbs::array_t<half * 2> limbs() const noexcept {
+            p_i_limbs::array_t<half * 2> out{};
+            p_storeLimbs(low, out, 0);
+            p_storeLimbs(high, out, p_i_limbs::count<half>());
+            return out;
+        }
+
+        constexpr inline static I
+        fromLimbs(const p_i_limbs::array_t<half * 2> &arr) noexcept {
+            I out(U::ZERO(), U::ZERO());
+            p_loadLimbs(out.low, arr, 0);
+            p_loadLimbs(out.high, arr, p_i_limbs::count<half>());
+            return out;
+        }
+
         constexpr inline static I
         rightShift(const I &value, const M shiftDistance) noexcept {
-            if (shiftDistance == 0) {
-                return value;
-            }
-            if (shiftDistance < (half * 8)) {
-                return I((value.low >> shiftDistance) |
-                        (value.high << (half * 8 - shiftDistance)),
-                        value.high >> shiftDistance);
-            }
-            return I(value.high >> (shiftDistance - half * 8), U::ZERO());
+            auto tmp = value.limbs();
+            p_i_limbs::shr(tmp, shiftDistance, 0);
+            return fromLimbs(tmp);
         }
 
         constexpr inline p_pow2_Integer_Base() noexcept = default;
@@ -1165,18 +1817,27 @@ namespace JIO {
         constexpr static M shmask = half * 2 * 8 - 1;
         U low, high;
 
+        constexpr inline p_i_limbs::array_t<half * 2> limbs() const noexcept {
+            p_i_limbs::array_t<half * 2> out{};
+            p_storeLimbs(low, out, 0);
+            p_storeLimbs(high, out, p_i_limbs::count<half>());
+            return out;
+        }
+
+        constexpr inline static I
+        fromLimbs(const p_i_limbs::array_t<half * 2> &arr) noexcept {
+            I out(U::ZERO(), U::ZERO());
+            p_loadLimbs(out.low, arr, 0);
+            p_loadLimbs(out.high, arr, p_i_limbs::count<half>());
+            return out;
+        }
+
         constexpr inline static I
         rightShift(const I &value, const M shiftDistance) noexcept {
-            if (shiftDistance == 0) {
-                return value;
-            }
-            if (shiftDistance < (half * 8)) {
-                return I((value.low >> shiftDistance) |
-                        (value.high << (half * 8 - shiftDistance)),
-                        S(value.high) >> shiftDistance);
-            }
-            return I(S(value.high) >> (shiftDistance - half * 8),
-                    value.high.upperBit() ? ~U::ZERO() : U::ZERO());
+            // arithmetic shift, vacated limbs are filled with the sign
+            auto tmp = value.limbs();
+            p_i_limbs::shr(tmp, shiftDistance, -p_i_limbs::L(value.isNegative()));
+            return fromLimbs(tmp);
         }
 
         constexpr inline p_pow2_Integer_Base() noexcept = default;
@@ -1239,15 +1900,9 @@ namespace JIO {
 
         constexpr inline static I
         leftShift(const I &value, const typename T::M shiftDistance) noexcept {
-            if (shiftDistance == 0) {
-                return value;
-            }
-            if (shiftDistance < (half * 8)) {
-                return I(value.low << shiftDistance,
-                        (value.high << shiftDistance) |
-                        (value.low >> (half * 8 - shiftDistance)));
-            }
-            return I(U::ZERO(), value.low << (shiftDistance - half * 8));
+            auto tmp = value.limbs();
+            p_i_limbs::shl(tmp, shiftDistance);
+            return T::fromLimbs(tmp);
         }
 
         using T::T;
@@ -1349,44 +2004,129 @@ namespace JIO {
             T::high.template setBit < index - half * p_i_native::min_native_bits > (v);
         }
 
-        constexpr inline static bool increment_overflow(I &value) noexcept {
-            return T::increment_overflow(value);
+        constexpr inline p_i_native::min_native_t
+        getByte(size_t index) const noexcept {
+            return index < half ? T::low.getByte(index) :
+                    T::high.getByte(index - half);
         }
 
-        constexpr inline static bool decrement_overflow(I &value) noexcept {
-            return T::decrement_overflow(value);
+        constexpr inline void
+        setByte(size_t index, p_i_native::min_native_t v) noexcept {
+            if (index < half) {
+                T::low.setByte(index, v);
+            } else {
+                T::high.setByte(index - half, v);
+            }
         }
 
-        constexpr inline static bool
-        increment_overflow_carry(I &value, bool cf) noexcept {
-            return T::increment_overflow_carry(value, cf);
+        constexpr inline bool getBit(size_t index) const noexcept {
+            constexpr size_t bits = half * p_i_native::min_native_bits;
+            return index < bits ? T::low.getBit(index) :
+                    T::high.getBit(index - bits);
         }
 
-        constexpr inline static bool
-        decrement_overflow_carry(I &value, bool cf) noexcept {
-            return T::decrement_overflow_carry(value, cf);
+        constexpr inline void setBit(size_t index, bool v) noexcept {
+            constexpr size_t bits = half * p_i_native::min_native_bits;
+            if (index < bits) {
+                T::low.setBit(index, v);
+            } else {
+                T::high.setBit(index - bits, v);
+            }
         }
 
-        constexpr inline static void
-        increment_carry(I &value, bool cf) noexcept {
-            U::add_zero_carry(U(value.high),
-                    U::increment_overflow_carry(value.low, cf), value.high);
+        constexpr inline void flipBit(size_t index) noexcept {
+            constexpr size_t bits = half * p_i_native::min_native_bits;
+            if (index < bits) {
+                T::low.flipBit(index);
+            } else {
+                T::high.flipBit(index - bits);
+            }
         }
 
-        constexpr inline static void
-        decrement_carry(I &value, bool cf) noexcept {
-            U::sub_zero_carry(U(value.high),
-                    U::decrement_overflow_carry(value.low, cf), value.high);
+        template<typename F>
+        inline void forEachSetBit(F &&f, size_t offset) const {
+            T::low.forEachSetBit(f, offset);
+            T::high.forEachSetBit(f, offset + half * p_i_native::min_native_bits);
         }
 
-        constexpr inline static bool
-        add_overflow(const I &v1, const I &v2, I &out) noexcept {
-            return T::add_overflow(v1, v2, out);
+        constexpr inline size_t bitCount() const noexcept {
+            return T::low.bitCount() + T::high.bitCount();
         }
 
-        constexpr inline static bool
-        sub_overflow(const I &v1, const I &v2, I &out) noexcept {
-            return T::sub_overflow(v1, v2, out);
+        constexpr inline I rotateLeft(const M distance) const noexcept {
+            return T::fromLimbs(p_i_limbs::rotl(T::limbs(), distance & T::shmask));
+        }
+
+        constexpr inline I reverseBytes() const noexcept {
+            return I(T::high.reverseBytes(), T::low.reverseBytes());
+        }
+
+        constexpr inline I reverse() const noexcept {
+            return I(T::high.reverse(), T::low.reverse());
+        }
+
+        constexpr inline I compress(const I &mask) const noexcept {
+            I low = I(T::low.compress(mask.low));
+            I high = I(T::high.compress(mask.high));
+            return low | (high << M(mask.low.bitCount()));
+        }
+
+        constexpr inline I expand(const I &mask) const noexcept {
+            // the high half takes the bits left after the low half
+            U high = (UI(*this) >> M(mask.low.bitCount())).low;
+            return I(T::low.expand(mask.low), high.expand(mask.high));
+        }
+
+        constexpr inline size_t rank(size_t index) const noexcept {
+            constexpr size_t bits = half * p_i_native::min_native_bits;
+            return index <= bits ? T::low.rank(index) :
+                    T::low.bitCount() + T::high.rank(index - bits);
+        }
+
+        constexpr inline size_t select(size_t k) const noexcept {
+            constexpr size_t bits = half * p_i_native::min_native_bits;
+            size_t c = T::low.bitCount();
+            return k < c ? T::low.select(k) : bits + T::high.select(k - c);
+        }
+
+        constexpr inline static bool increment_overflow(I &value) noexcept {
+            return T::increment_overflow(value);
+        }
+
+        constexpr inline static bool decrement_overflow(I &value) noexcept {
+            return T::decrement_overflow(value);
+        }
+
+        constexpr inline static bool
+        increment_overflow_carry(I &value, bool cf) noexcept {
+            return T::increment_overflow_carry(value, cf);
+        }
+
+        constexpr inline static bool
+        decrement_overflow_carry(I &value, bool cf) noexcept {
+            return T::decrement_overflow_carry(value, cf);
+        }
+
+        constexpr inline static void
+        increment_carry(I &value, bool cf) noexcept {
+            U::add_zero_carry(U(value.high),
+                    U::increment_overflow_carry(value.low, cf), value.high);
+        }
+
+        constexpr inline static void
+        decrement_carry(I &value, bool cf) noexcept {
+            U::sub_zero_carry(U(value.high),
+                    U::decrement_overflow_carry(value.low, cf), value.high);
+        }
+
+        constexpr inline static bool
+        add_overflow(const I &v1, const I &v2, I &out) noexcept {
+            return T::add_overflow(v1, v2, out);
+        }
+
+        constexpr inline static bool
+        sub_overflow(const I &v1, const I &v2, I &out) noexcept {
+            return T::sub_overflow(v1, v2, out);
         }
 
         constexpr inline static bool
@@ -1468,7 +2208,7 @@ namespace JIO {
 
         template<typename II = Integer<half * 2, sig>>
         constexpr inline I operator%(const I &other) const noexcept {
-            II rem;
+            II rem = II::ZERO();
             divrem(II(*this), II(other), &rem);
             return rem.value;
         }
@@ -1489,7 +2229,18 @@ namespace JIO {
 
         constexpr inline I operator*(const I &other) const noexcept {
             auto tmp = wmultiply(T::low, other.low).value;
+#if INTEGER_HPP_ADAPTIVE
+            // cross products with an all-zero half are skipped
+            if (!other.high.isZero()) {
+                tmp.high = tmp.high + T::low * other.high;
+            }
+            if (!T::high.isZero()) {
+                tmp.high = tmp.high + T::high * other.low;
+            }
+            return I(tmp.low, tmp.high);
+#else
             return I(tmp.low, tmp.high + T::low * other.high + T::high * other.low);
+#endif
         }
 
         constexpr inline I operator<<(const M other) const noexcept {
@@ -1540,10 +2291,17 @@ namespace JIO {
         template<typename R, typename T, bool V = true >
         using if_bool_t = if_t<R, is_same_cv<T, bool>() && V>;
 
+        // std::is_signed does not fail on class types, so this stays usable
+        // in default template arguments of the integral operators
         template<typename T>
         constexpr inline bool is_signed() noexcept {
-            return T(-1) < T(0);
+            return std::is_signed<T>::value;
         }
+
+        // T in a parameter that must not take part in the deduction,
+        // so that nullptr can be passed to pointers to it
+        template<typename T>
+        using no_deduce_t = if_t<T, true>;
     }
 
     template<typename U, typename S, bool sig>
@@ -1569,6 +2327,15 @@ namespace JIO {
         UI q = UI::ZERO();
         UI r = UI::ZERO();
         size_t sr = 0;
+        if (b.numberOfLeadingZeros() >= n_word_bits - p_i_limbs::limb_bits) {
+            // b fits in one limb, short division
+            p_i_limbs::L tmp = 0;
+            q = p_udivrem_n(a, p_i_limbs::L(b), &tmp);
+            if (rem) {
+                *rem = UI(tmp);
+            }
+            return q;
+        }
         // special cases, X is unknown, K != 0
         if (a.uhigh().isZero()) {
             if (b.uhigh().isZero()) {
@@ -1726,22 +2493,60 @@ namespace JIO {
         return q;
     }
 
-    template<size_t size, typename UI = Integer<size, false>,
-    typename SI = Integer<size, true> >
+    // rounding of the quotient, the remainder is x - q * y. Euclid's
+    // remainder is never negative
+    enum p_DivRound {
+        round_trunc,
+        round_floor,
+        round_ceil,
+        round_euclid
+    };
+
+    // whether a truncated quotient with a non zero remainder moves away
+    // from zero
+    constexpr inline bool p_roundsAway(p_DivRound mode, bool xNeg, bool yNeg) noexcept {
+        return mode == round_floor ? xNeg != yNeg :
+                mode == round_ceil ? xNeg == yNeg :
+                mode == round_euclid && xNeg;
+    }
+
+    template<p_DivRound mode = round_trunc, size_t size,
+    typename UI = Integer<size, false>, typename SI = Integer<size, true> >
     constexpr inline ct::if_t<SI, p_intType(size) == pow2>
     p_sdivrem(const Integer<size, true> &x,
             const Integer<size, true> &y, Integer<size, true> *rem) noexcept {
         bool xNeg = x.isNegative();
         bool yNeg = y.isNegative();
-        UI q;
+        if (!y.isZero() && !yNeg && (y & (y - 1)).isZero()) {
+            // arithmetic shift, the floor, and a bias of one for a
+            // non zero remainder rounded up, as truncation does for x < 0
+            const size_t s = y.numberOfTrailingZeros();
+            SI q = x >> s;
+            SI r = x & (y - 1);
+            if (!r.isZero() && (mode == round_ceil ||
+                    (mode == round_trunc && xNeg))) {
+                q += 1;
+                r -= y;
+            }
+            if (rem) {
+                *rem = r;
+            }
+            return q;
+        }
+        UI r = UI::ZERO();
+        UI uy = yNeg ? -y : y;
+        UI q = p_udivrem<size>(xNeg ? -x : x, uy, &r);
+        // |q| + 1 and |y| - |r|, away from zero
+        if (!r.isZero() && p_roundsAway(mode, xNeg, yNeg)) {
+            q += 1U;
+            r = uy - r;
+            xNeg = mode == round_euclid ? false :
+                    mode == round_floor ? yNeg : !yNeg;
+        }
         if (rem) {
-            UI r;
-            q = p_udivrem<size>(xNeg ? -x : x, yNeg ? -y : y, &r);
             *rem = xNeg ? -r : r;
-        } else {
-            q = p_udivrem<size>(xNeg ? -x : x, yNeg ? -y : y, nullptr);
         }
-        return xNeg ^ yNeg ? -q : q;
+        return SI(x.isNegative() ^ yNeg ? -q : q);
     }
 
     template<size_t size, bool sig, p_IType = p_intType(size)>
@@ -1792,6 +2597,80 @@ namespace JIO {
         return p_divrem_h<size, sig>::divrem(x, y, rem);
     }
 
+    template<p_DivRound mode, size_t size, bool sig>
+    constexpr inline ct::if_t<Integer<size, sig>, sig && p_intType(size) == pow2>
+    p_divround(const Integer<size, sig> &x, const Integer<size, sig> &y,
+            Integer<size, sig> *rem) noexcept {
+        return p_sdivrem<mode>(x, y, rem);
+    }
+
+    // native quotients truncate, they are moved away from zero afterwards
+    template<p_DivRound mode, size_t size, bool sig>
+    constexpr inline ct::if_t<Integer<size, sig>, !sig || p_intType(size) != pow2>
+    p_divround(const Integer<size, sig> &x, const Integer<size, sig> &y,
+            Integer<size, sig> *rem) noexcept {
+        using I = Integer<size, sig>;
+        I r = I::ZERO();
+        I q = divrem(x, y, &r);
+        if (!r.isZero() && p_roundsAway(mode, x.isNegative(), y.isNegative())) {
+            const bool up = mode == round_ceil ||
+                    (mode == round_euclid && y.isNegative());
+            q = up ? I(q + I(1)) : I(q - I(1));
+            r = up ? I(r - y) : I(r + y);
+        }
+        if (rem) {
+            *rem = r;
+        }
+        return q;
+    }
+
+    // quotient rounded toward negative infinity, the remainder has
+    // the sign of y
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> div_floor(const Integer<size, sig> &x,
+            const Integer<size, sig> &y, Integer<size, sig> *rem = nullptr) noexcept {
+        return p_divround<round_floor>(x, y, rem);
+    }
+
+    // quotient rounded toward positive infinity, the remainder has the
+    // opposite sign of y, modulo 2^(size * 8) if unsigned
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> div_ceil(const Integer<size, sig> &x,
+            const Integer<size, sig> &y, Integer<size, sig> *rem = nullptr) noexcept {
+        return p_divround<round_ceil>(x, y, rem);
+    }
+
+    // the quotient for which the remainder is in [0, |y|)
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> div_euclid(const Integer<size, sig> &x,
+            const Integer<size, sig> &y, Integer<size, sig> *rem = nullptr) noexcept {
+        return p_divround<round_euclid>(x, y, rem);
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> mod_floor(const Integer<size, sig> &x,
+            const Integer<size, sig> &y) noexcept {
+        Integer<size, sig> r = Integer<size, sig>::ZERO();
+        p_divround<round_floor>(x, y, &r);
+        return r;
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> mod_ceil(const Integer<size, sig> &x,
+            const Integer<size, sig> &y) noexcept {
+        Integer<size, sig> r = Integer<size, sig>::ZERO();
+        p_divround<round_ceil>(x, y, &r);
+        return r;
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig> mod_euclid(const Integer<size, sig> &x,
+            const Integer<size, sig> &y) noexcept {
+        Integer<size, sig> r = Integer<size, sig>::ZERO();
+        p_divround<round_euclid>(x, y, &r);
+        return r;
+    }
+
     //TODO
 
     template<size_t size, typename R = Integer<size * 2, false> >
@@ -1802,19 +2681,13 @@ namespace JIO {
         return R(v1) * R(v2);
     }
 
-    template<size_t size, typename U1 = Integer<size / 2, false >,
-    typename U2 = Integer<size, false>, typename U4 = Integer<size * 2, false> >
+    template<size_t size, typename U4 = Integer<size * 2, false> >
     constexpr inline ct::if_t<U4, size == p_i_native::max_native_size>
     wmultiply(const Integer<size, false> &v1,
             const Integer<size, false> &v2) noexcept {
-        U1 a = U1(v1 >> (size * 4)), b = U1(v1);
-        U1 c = U1(v2 >> (size * 4)), d = U1(v2);
-        U2 ac = wmultiply(a, c);
-        U2 bd = wmultiply(b, d);
-        U2 ad = wmultiply(a, d);
-        U2 bc = wmultiply(b, c);
-        U4 abcd = U4(ad) + U4(bc);
-        return U4(bd, ac) + (abcd << (size * 4));
+        p_i_limbs::L high = 0;
+        p_i_limbs::L low = p_i_limbs::mul(v1.uvalue(), v2.uvalue(), high);
+        return U4(low, high);
     }
 
     template<size_t size, typename U1 = Integer<size / 2, false >,
@@ -1824,6 +2697,17 @@ namespace JIO {
             const Integer<size, false> &v2) noexcept {
         U1 a = v1.uhigh(), b = v1.ulow();
         U1 c = v2.uhigh(), d = v2.ulow();
+#if INTEGER_HPP_ADAPTIVE
+        // the effective length is halved, two or one half products
+        if (a.isZero()) {
+            U2 bd = wmultiply(b, d);
+            return c.isZero() ? U4(bd) :
+                    U4(bd) + (U4(wmultiply(b, c)) << (size * 4));
+        }
+        if (c.isZero()) {
+            return U4(wmultiply(b, d)) + (U4(wmultiply(a, d)) << (size * 4));
+        }
+#endif
         U2 ac = wmultiply(a, c);
         U2 bd = wmultiply(b, d);
 #if 1 //The Karatsuba algorithm
@@ -1845,11 +2729,148 @@ namespace JIO {
         return U4(bd, ac) + (abcd << (size * 4));
     }
 
+    // sig is deduced, so wmultiply<size>(x, y) with native
+    // arguments still picks the unsigned overloads
+
+    template<size_t size, bool sig, typename R = Integer<size * 2, true> >
+    constexpr inline ct::if_t<R, sig && (p_intType(size) == native) &&
+    (size != p_i_native::max_native_size) >
+    wmultiply(const Integer<size, sig> &v1,
+            const Integer<size, sig> &v2) noexcept {
+        return R(v1) * R(v2);
+    }
+
+    template<size_t size, bool sig, typename U2 = Integer<size, false>,
+    typename S4 = Integer<size * 2, true> >
+    constexpr inline ct::if_t<S4, sig && ((size == p_i_native::max_native_size) ||
+    (p_intType(size) == pow2)) >
+    wmultiply(const Integer<size, sig> &v1,
+            const Integer<size, sig> &v2) noexcept {
+        // a * b = ua * ub - (a < 0 ? ub * B : 0) - (b < 0 ? ua * B : 0)
+        S4 out = wmultiply(U2(v1), U2(v2));
+        out.uhigh() -= (v1.isNegative() ? U2(v2) : U2::ZERO()) +
+                (v2.isNegative() ? U2(v1) : U2::ZERO());
+        return out;
+    }
+
+    // high half of the double width product
+    template<size_t size, bool sig, typename I = Integer<size, sig> >
+    constexpr inline ct::if_t<I, (p_intType(size) == native) &&
+    (size != p_i_native::max_native_size) >
+    mulhi(const Integer<size, sig> &v1, const Integer<size, sig> &v2) noexcept {
+        return I(wmultiply(v1, v2) >> (size * p_i_native::min_native_bits));
+    }
+
+    template<size_t size, bool sig, typename I = Integer<size, sig> >
+    constexpr inline ct::if_t<I, size == p_i_native::max_native_size>
+    mulhi(const Integer<size, sig> &v1, const Integer<size, sig> &v2) noexcept {
+        p_i_limbs::L high = 0;
+        p_i_limbs::mul(v1.uvalue(), v2.uvalue(), high);
+        I out = I(high);
+        if (sig) {
+            out -= (v1.isNegative() ? v2 : I::ZERO()) +
+                    (v2.isNegative() ? v1 : I::ZERO());
+        }
+        return out;
+    }
+
+    template<size_t size, bool sig, typename I = Integer<size, sig>,
+    typename U1 = Integer<size / 2, false>, typename U2 = Integer<size, false> >
+    constexpr inline ct::if_t<I, p_intType(size) == pow2>
+    mulhi(const Integer<size, sig> &v1, const Integer<size, sig> &v2) noexcept {
+        // only the high half of b * d is needed, the low one
+        // is never built:
+        // hi(ab * cd) = a * c + hi(a * d + b * c + hi(b * d))
+        U1 a = v1.uhigh(), b = v1.ulow();
+        U1 c = v2.uhigh(), d = v2.ulow();
+        U2 mid = U2::ZERO();
+        bool carry1 = U2::add_overflow(wmultiply(a, d), wmultiply(b, c), mid);
+        bool carry2 = U2::add_overflow(U2(mid), U2(mulhi(b, d)), mid);
+        U2 out = wmultiply(a, c) + U2(mid.uhigh(),
+                U1(unsigned(carry1) + unsigned(carry2)));
+        if (sig) {
+            out -= (v1.isNegative() ? U2(v2) : U2::ZERO()) +
+                    (v2.isNegative() ? U2(v1) : U2::ZERO());
+        }
+        return out;
+    }
+
+    template<size_t size, typename R = Integer<size * 2, false> >
+    constexpr inline ct::if_t<R, p_intType(size) == native>
+    wsquare(const Integer<size, false> &v) noexcept {
+        return wmultiply(v, v);
+    }
+
+    template<size_t size, typename U1 = Integer<size / 2, false >,
+    typename U2 = Integer<size, false>, typename U4 = Integer<size * 2, false> >
+    constexpr inline ct::if_t<U4, p_intType(size) == pow2>
+    wsquare(const Integer<size, false> &v) noexcept {
+        // (a * B + b)^2 = a^2 * B^2 + 2 * a * b * B + b^2,
+        // the cross product is computed once
+        U1 a = v.uhigh(), b = v.ulow();
+#if INTEGER_HPP_ADAPTIVE
+        if (a.isZero()) {
+            return U4(wsquare(b));
+        }
+#endif
+        U2 aa = wsquare(a);
+        U2 bb = wsquare(b);
+        U2 ab = wmultiply(a, b);
+        return U4(bb, aa) + (U4(ab) << (size * 4 + 1));
+    }
+
+    template<size_t size, bool sig, typename R = Integer<size * 2, true> >
+    constexpr inline ct::if_t<R, sig>
+    wsquare(const Integer<size, sig> &v) noexcept {
+        Integer<size, false> abs = v.isNegative() ? -v : v;
+        return wsquare(abs);
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<Integer<size, sig>, p_intType(size) == native>
+    sqr(const Integer<size, sig> &v) noexcept {
+        return v * v;
+    }
+
+    template<size_t size, bool sig, typename U1 = Integer<size / 2, false >,
+    typename U2 = Integer<size, false> >
+    constexpr inline ct::if_t<Integer<size, sig>, p_intType(size) == pow2>
+    sqr(const Integer<size, sig> &v) noexcept {
+        // only the low half of 2 * a * b * B is needed
+        U1 a = v.uhigh(), b = v.ulow();
+        U2 bb = wsquare(b);
+        return U2(bb.ulow(), bb.uhigh() + ((a * b) << 1));
+    }
+
     template<size_t size1, size_t size2, bool sig1, bool sig2>
     using result_t = Integer<(size1 < size2 ? size2 : size1),
     (size1 == size2) ? sig1 && sig2 :
     (size1 > size2 ? sig1 : sig2)>;
 
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_addMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept;
+
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_subMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept;
+
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_mulMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept;
+
+#if INTEGER_HPP_HAS_CMATH
+
+    template<typename F, size_t size, bool sig>
+    inline F p_toFloat(const Integer<size, sig> &v) noexcept;
+
+    template<size_t size, bool sig, typename F>
+    inline Integer<size, sig> p_fromFloat(const F x) noexcept;
+#endif
+
     template<size_t size, bool sig, p_IType = p_intType(size)>
     class Integer_Base;
 
@@ -2073,6 +3094,129 @@ namespace JIO {
             return *this;
         }
 
+        // runtime index versions, index must be less than size (in bytes)
+        // or size * min_native_bits (in bits)
+
+        constexpr inline p_i_native::min_native_t
+        getByte(size_t index) const noexcept {
+            return value.getByte(index);
+        }
+
+        constexpr inline Integer&
+        setByte(size_t index, p_i_native::min_native_t v) noexcept {
+            value.setByte(index, v);
+            return *this;
+        }
+
+        constexpr inline bool getBit(size_t index) const noexcept {
+            return value.getBit(index);
+        }
+
+        constexpr inline Integer& setBit(size_t index, bool v) noexcept {
+            value.setBit(index, v);
+            return *this;
+        }
+
+        constexpr inline Integer& flipBit(size_t index) noexcept {
+            value.flipBit(index);
+            return *this;
+        }
+
+        // calls f(offset + i) for every set bit i in ascending order
+        template<typename F>
+        inline void forEachSetBit(F &&f, size_t offset = 0) const {
+            value.forEachSetBit(f, offset);
+        }
+
+        constexpr inline size_t bitCount() const noexcept {
+            return value.bitCount();
+        }
+
+        // number of set bits below index, 0 <= index <= size * min_native_bits
+        constexpr inline size_t rank(size_t index) const noexcept {
+            return value.rank(index);
+        }
+
+        // position of the k-th (from 0) set bit or
+        // size * min_native_bits if there is no such bit
+        constexpr inline size_t select(size_t k) const noexcept {
+            return value.select(k);
+        }
+
+        template<size_t size2, bool sig2>
+        constexpr inline Integer
+        rotateLeft(const Integer<size2, sig2> &distance) const noexcept {
+            return value.rotateLeft(p_SHType<size>(distance));
+        }
+
+        template<typename T>
+        constexpr inline ct::if_int_t<Integer, T>
+        rotateLeft(const T distance) const noexcept {
+            return value.rotateLeft(p_SHType<size>(distance));
+        }
+
+        template<size_t size2, bool sig2>
+        constexpr inline Integer
+        rotateRight(const Integer<size2, sig2> &distance) const noexcept {
+            return value.rotateLeft(0 - p_SHType<size>(distance));
+        }
+
+        template<typename T>
+        constexpr inline ct::if_int_t<Integer, T>
+        rotateRight(const T distance) const noexcept {
+            return value.rotateLeft(0 - p_SHType<size>(distance));
+        }
+
+        constexpr inline Integer reverseBytes() const noexcept {
+            return value.reverseBytes();
+        }
+
+        constexpr inline Integer reverse() const noexcept {
+            return value.reverse();
+        }
+
+    private:
+
+        // width low bits set, 0 <= width <= size * min_native_bits
+        constexpr inline static Integer<size, false>
+        lowBits(size_t width) noexcept {
+            return width ? ~Integer<size, false>::ZERO() >>
+                    (size * p_i_native::min_native_bits - width) :
+                    Integer<size, false>::ZERO();
+        }
+    public:
+
+        // bits [offset, offset + width) moved to the bottom and zero
+        // extended, the bits past the top read as zero
+        constexpr inline Integer
+        extract(size_t offset, size_t width) const noexcept {
+            constexpr size_t bits = size * p_i_native::min_native_bits;
+            return offset >= bits ? Integer::ZERO() :
+                    Integer((u() >> offset) & lowBits(p_i_native::min(width, bits)));
+        }
+
+        // bits [offset, offset + width) replaced with the low bits of field,
+        // the bits past the top are not written
+        constexpr inline Integer deposit(size_t offset, size_t width,
+                const Integer &field) const noexcept {
+            constexpr size_t bits = size * p_i_native::min_native_bits;
+            if (offset >= bits) {
+                return *this;
+            }
+            Integer<size, false> mask = lowBits(p_i_native::min(width, bits - offset)) << offset;
+            return (u() & ~mask) | ((field.u() << offset) & mask);
+        }
+
+        // pext, bits selected by mask are packed to the bottom
+        constexpr inline Integer compress(const Integer &mask) const noexcept {
+            return value.compress(mask.value);
+        }
+
+        // pdep, low bits are scattered to the positions selected by mask
+        constexpr inline Integer expand(const Integer &mask) const noexcept {
+            return value.expand(mask.value);
+        }
+
         constexpr inline static bool increment_overflow(Integer &value) noexcept {
             return V::increment_overflow(value.value);
         }
@@ -2231,6 +3375,15 @@ namespace JIO {
         constexpr inline Integer(const T n) noexcept :
         Integer(V(tcast_h<T>::tcast(n))) { }
 
+#if INTEGER_HPP_HAS_CMATH
+
+        // truncates toward zero modulo 2^(size * 8),
+        // NaN and infinities give zero
+        template<typename F, ct::if_t<bool, std::is_floating_point<F>::value> = true >
+        explicit inline Integer(const F x) noexcept :
+        Integer(p_fromFloat<size, sig>(x)) { }
+#endif
+
         template<size_t size2, bool sig2, ct::if_t<bool, (size2 >= size)> = true >
         constexpr inline operator Integer<size2, sig2>() const noexcept {
             return upcast<size2, sig2>();
@@ -2274,48 +3427,163 @@ namespace JIO {
             }
         };
 
-    public:
+        // mixed width operations, a wide pow2 operand is not promoted
+        // against a native or narrower one
+        template<size_t size2, bool sig2, typename R,
+        int = (p_intType(size) == pow2) && (size2 < size) ? 1 :
+        (p_intType(size2) == pow2) && (size < size2) ? 2 : 0>
+        struct mixed_h {
 
-        template<typename T, ct::if_int_t<bool, T> = true >
-        constexpr inline operator T() const noexcept {
-            return pcast_h<T>::pcast(*this);
-        }
+            constexpr inline static R
+            add(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value + R(b).value;
+            }
 
-        template<typename T, ct::if_bool_t<bool, T> = true >
-        constexpr inline operator T() const noexcept {
-            return !(this->isZero());
-        }
+            constexpr inline static R
+            sub(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value - R(b).value;
+            }
 
-        template<size_t size2, bool sig2,
-        typename R = result_t<size, size2, sig, sig2>>
-        constexpr inline R
-        operator+(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value + R(v2).value;
-        }
+            constexpr inline static R
+            mul(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value * R(b).value;
+            }
 
-        template<size_t size2, bool sig2,
-        typename R = result_t<size, size2, sig, sig2>>
-        constexpr inline R
-        operator-(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value - R(v2).value;
-        }
+            constexpr inline static bool
+            eq(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value == R(b).value;
+            }
 
-        template<size_t size2, bool sig2,
-        typename R = result_t<size, size2, sig, sig2>>
-        constexpr inline R
-        operator*(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value * R(v2).value;
-        }
+            constexpr inline static bool
+            lt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value < R(b).value;
+            }
 
-        template<size_t size2, bool sig2,
-        typename R = result_t<size, size2, sig, sig2>>
-        constexpr inline R
-        operator/(const Integer<size2, sig2> &v2) const noexcept {
-            return typename R::V(R(*this).value / R(v2).value);
-        }
+            constexpr inline static bool
+            gt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return R(a).value > R(b).value;
+            }
+        };
 
-        template<size_t size2, bool sig2,
-        typename R = result_t<size, size2, sig, sig2>>
+        template<size_t size2, bool sig2, typename R>
+        struct mixed_h<size2, sig2, R, 1> {
+
+            constexpr inline static R
+            add(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_addMixed<R>(a, b);
+            }
+
+            constexpr inline static R
+            sub(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_subMixed<R>(a, b);
+            }
+
+            constexpr inline static R
+            mul(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_mulMixed<R>(a, b);
+            }
+
+            constexpr inline static bool
+            eq(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(a, b) == 0;
+            }
+
+            constexpr inline static bool
+            lt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(a, b) < 0;
+            }
+
+            constexpr inline static bool
+            gt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(a, b) > 0;
+            }
+        };
+
+        template<size_t size2, bool sig2, typename R>
+        struct mixed_h<size2, sig2, R, 2> {
+
+            constexpr inline static R
+            add(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_addMixed<R>(b, a);
+            }
+
+            constexpr inline static R
+            sub(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return -p_subMixed<R>(b, a);
+            }
+
+            constexpr inline static R
+            mul(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_mulMixed<R>(b, a);
+            }
+
+            constexpr inline static bool
+            eq(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(b, a) == 0;
+            }
+
+            constexpr inline static bool
+            lt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(b, a) > 0;
+            }
+
+            constexpr inline static bool
+            gt(const Integer &a, const Integer<size2, sig2> &b) noexcept {
+                return p_compareMixed(b, a) < 0;
+            }
+        };
+
+    public:
+
+        template<typename T, ct::if_int_t<bool, T> = true >
+        constexpr inline operator T() const noexcept {
+            return pcast_h<T>::pcast(*this);
+        }
+
+        template<typename T, ct::if_bool_t<bool, T> = true >
+        constexpr inline operator T() const noexcept {
+            return !(this->isZero());
+        }
+
+#if INTEGER_HPP_HAS_CMATH
+
+        // rounds to nearest, ties to even
+        template<typename F, ct::if_t<bool, std::is_floating_point<F>::value> = true >
+        explicit inline operator F() const noexcept {
+            return p_toFloat<F>(*this);
+        }
+#endif
+
+        template<size_t size2, bool sig2,
+        typename R = result_t<size, size2, sig, sig2>>
+        constexpr inline R
+        operator+(const Integer<size2, sig2> &v2) const noexcept {
+            return mixed_h<size2, sig2, R>::add(*this, v2);
+        }
+
+        template<size_t size2, bool sig2,
+        typename R = result_t<size, size2, sig, sig2>>
+        constexpr inline R
+        operator-(const Integer<size2, sig2> &v2) const noexcept {
+            return mixed_h<size2, sig2, R>::sub(*this, v2);
+        }
+
+        template<size_t size2, bool sig2,
+        typename R = result_t<size, size2, sig, sig2>>
+        constexpr inline R
+        operator*(const Integer<size2, sig2> &v2) const noexcept {
+            return mixed_h<size2, sig2, R>::mul(*this, v2);
+        }
+
+        template<size_t size2, bool sig2,
+        typename R = result_t<size, size2, sig, sig2>>
+        constexpr inline R
+        operator/(const Integer<size2, sig2> &v2) const noexcept {
+            return typename R::V(R(*this).value / R(v2).value);
+        }
+
+        template<size_t size2, bool sig2,
+        typename R = result_t<size, size2, sig, sig2>>
         constexpr inline R
         operator%(const Integer<size2, sig2> &v2) const noexcept {
             return typename R::V(R(*this).value % R(v2).value);
@@ -2370,42 +3638,42 @@ namespace JIO {
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator==(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value == R(v2).value;
+            return mixed_h<size2, sig2, R>::eq(*this, v2);
         }
 
         template<size_t size2, bool sig2,
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator!=(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value != R(v2).value;
+            return !mixed_h<size2, sig2, R>::eq(*this, v2);
         }
 
         template<size_t size2, bool sig2,
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator<=(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value <= R(v2).value;
+            return !mixed_h<size2, sig2, R>::gt(*this, v2);
         }
 
         template<size_t size2, bool sig2,
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator>=(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value >= R(v2).value;
+            return !mixed_h<size2, sig2, R>::lt(*this, v2);
         }
 
         template<size_t size2, bool sig2,
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator<(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value < R(v2).value;
+            return mixed_h<size2, sig2, R>::lt(*this, v2);
         }
 
         template<size_t size2, bool sig2,
         typename R = result_t<size, size2, sig, sig2>>
         constexpr inline bool
         operator>(const Integer<size2, sig2> &v2) const noexcept {
-            return R(*this).value > R(v2).value;
+            return mixed_h<size2, sig2, R>::gt(*this, v2);
         }
 
         constexpr inline Integer operator~() const noexcept {
@@ -2450,24 +3718,486 @@ namespace JIO {
         friend struct p_pow2_Integer_Impl;
     };
 
-#if INTEGER_HPP_HAS_OSTREAM
-    namespace p_i_print {
+    template<size_t size, bool sig, typename A>
+    constexpr inline ct::if_t<void, size == p_i_native::max_native_size>
+    p_storeLimbs(const Integer<size, sig> &v, A &arr, size_t offset) noexcept {
+        arr[offset] = v.uvalue();
+    }
 
-        template<size_t size, size_t... index,
-        typename R = Integer<size, false >>
-        constexpr inline R
-        div_ten_const_h(p_i_seq::array_t<size_t, index...>) noexcept {
-            R out = R::ZERO();
-            p_i_seq::unused_array({
-                (out.template setByte<index>(index == 0 ? 0xcd : 0xcc))...
-            });
-            return out;
+    template<size_t size, bool sig, typename A>
+    constexpr inline ct::if_t<void, p_intType(size) == pow2>
+    p_storeLimbs(const Integer<size, sig> &v, A &arr, size_t offset) noexcept {
+        p_storeLimbs(v.ulow(), arr, offset);
+        p_storeLimbs(v.uhigh(), arr, offset + p_i_limbs::count<size / 2>());
+    }
+
+    template<size_t size, bool sig, typename A>
+    constexpr inline ct::if_t<void, size == p_i_native::max_native_size>
+    p_loadLimbs(Integer<size, sig> &v, const A &arr, size_t offset) noexcept {
+        v.uvalue() = arr[offset];
+    }
+
+    template<size_t size, bool sig, typename A>
+    constexpr inline ct::if_t<void, p_intType(size) == pow2>
+    p_loadLimbs(Integer<size, sig> &v, const A &arr, size_t offset) noexcept {
+        p_loadLimbs(v.ulow(), arr, offset);
+        p_loadLimbs(v.uhigh(), arr, offset + p_i_limbs::count<size / 2>());
+    }
+
+    // the limb i of v, i is known at compile time
+    template<size_t i, size_t size, bool sig>
+    constexpr inline ct::if_t<p_i_limbs::L&, size == p_i_native::max_native_size>
+    p_limbAt(Integer<size, sig> &v) noexcept {
+        return v.uvalue();
+    }
+
+    template<size_t i, size_t size, bool sig>
+    constexpr inline ct::if_t<p_i_limbs::L&, (p_intType(size) == pow2) &&
+    (i < p_i_limbs::count<size / 2>())>
+    p_limbAt(Integer<size, sig> &v) noexcept {
+        return p_limbAt<i>(v.ulow());
+    }
+
+    template<size_t i, size_t size, bool sig>
+    constexpr inline ct::if_t<p_i_limbs::L&, (p_intType(size) == pow2) &&
+    (i >= p_i_limbs::count<size / 2>())>
+    p_limbAt(Integer<size, sig> &v) noexcept {
+        return p_limbAt<i - p_i_limbs::count<size / 2>()>(v.uhigh());
+    }
+
+    // the limb i of v, or fill when i is out of range
+    template<p_i_seq::signed_size_t i, size_t size, bool sig>
+    constexpr inline ct::if_t<p_i_limbs::L, (i < 0) ||
+    (i >= p_i_seq::signed_size_t(p_i_limbs::count<size>()))>
+    p_limbOr(Integer<size, sig>&, p_i_limbs::L fill) noexcept {
+        return fill;
+    }
+
+    template<p_i_seq::signed_size_t i, size_t size, bool sig>
+    constexpr inline ct::if_t<p_i_limbs::L, (i >= 0) &&
+    (i < p_i_seq::signed_size_t(p_i_limbs::count<size>()))>
+    p_limbOr(Integer<size, sig> &v, p_i_limbs::L) noexcept {
+        return p_limbAt<size_t(i)>(v);
+    }
+
+    // v += x + cf in place, returns the carry out
+    template<size_t size, bool sig, bool sig2>
+    constexpr inline ct::if_t<bool, p_intType(size) == native>
+    p_addCarry(Integer<size, sig> &v, const Integer<size, sig2> &x,
+            bool cf) noexcept {
+        using I = Integer<size, false>;
+        I tmp = I::ZERO();
+        bool out = I::add_overflow_carry(I(v), I(x), cf, tmp);
+        v = tmp;
+        return out;
+    }
+
+    template<size_t size, bool sig, bool sig2>
+    constexpr inline ct::if_t<bool, p_intType(size) == pow2>
+    p_addCarry(Integer<size, sig> &v, const Integer<size, sig2> &x,
+            bool cf) noexcept {
+        return p_addCarry(v.uhigh(), x.uhigh(),
+                p_addCarry(v.ulow(), x.ulow(), cf));
+    }
+
+    template<size_t size, bool sig, bool sig2>
+    constexpr inline ct::if_t<bool, p_intType(size) == native>
+    p_subCarry(Integer<size, sig> &v, const Integer<size, sig2> &x,
+            bool cf) noexcept {
+        using I = Integer<size, false>;
+        I tmp = I::ZERO();
+        bool out = I::sub_overflow_carry(I(v), I(x), cf, tmp);
+        v = tmp;
+        return out;
+    }
+
+    template<size_t size, bool sig, bool sig2>
+    constexpr inline ct::if_t<bool, p_intType(size) == pow2>
+    p_subCarry(Integer<size, sig> &v, const Integer<size, sig2> &x,
+            bool cf) noexcept {
+        return p_subCarry(v.uhigh(), x.uhigh(),
+                p_subCarry(v.ulow(), x.ulow(), cf));
+    }
+
+    // ++v in place, the upper half is touched only on a carry
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<bool, p_intType(size) == native>
+    p_increment(Integer<size, sig> &v) noexcept {
+        return ++v.uvalue() == 0;
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<bool, p_intType(size) == pow2>
+    p_increment(Integer<size, sig> &v) noexcept {
+        return p_increment(v.ulow()) && p_increment(v.uhigh());
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<bool, p_intType(size) == native>
+    p_decrement(Integer<size, sig> &v) noexcept {
+        return v.uvalue()-- == 0;
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<bool, p_intType(size) == pow2>
+    p_decrement(Integer<size, sig> &v) noexcept {
+        return p_decrement(v.ulow()) && p_decrement(v.uhigh());
+    }
+
+    // v += x, x is not wider than v. The carry goes to the upper half only
+    // when it is set, so small deltas touch only the low limbs
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, size == size2>
+    p_addNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_addCarry(v, x, false);
+    }
+
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, (size > size2) &&
+    (p_intType(size) == native) >
+    p_addNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_addCarry(v, Integer<size, false>(x), false);
+    }
+
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, (size > size2) &&
+    (p_intType(size) == pow2) >
+    p_addNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_addNarrow(v.ulow(), x) && p_increment(v.uhigh());
+    }
+
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, size == size2>
+    p_subNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_subCarry(v, x, false);
+    }
+
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, (size > size2) &&
+    (p_intType(size) == native) >
+    p_subNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_subCarry(v, Integer<size, false>(x), false);
+    }
+
+    template<size_t size, bool sig, size_t size2>
+    constexpr inline ct::if_t<bool, (size > size2) &&
+    (p_intType(size) == pow2) >
+    p_subNarrow(Integer<size, sig> &v, const Integer<size2, false> &x) noexcept {
+        return p_subNarrow(v.ulow(), x) && p_decrement(v.uhigh());
+    }
+
+    // three-way unsigned comparison of v with x extended by fill bits
+    template<size_t size, size_t size2>
+    constexpr inline ct::if_t<int, (size == size2) ||
+    (p_intType(size) == native) >
+    p_compareNarrow(const Integer<size, false> &v,
+            const Integer<size2, false> &x, bool fill) noexcept {
+        using I = Integer<size, false>;
+        I tmp = fill ? I(Integer<size2, true>(x)) : I(x);
+        return v < tmp ? -1 : v != tmp;
+    }
+
+    template<size_t size, size_t size2>
+    constexpr inline ct::if_t<int, (size > size2) &&
+    (p_intType(size) == pow2) >
+    p_compareNarrow(const Integer<size, false> &v,
+            const Integer<size2, false> &x, bool fill) noexcept {
+        using U = Integer<size / 2, false>;
+        const U f = fill ? ~U::ZERO() : U::ZERO();
+        return v.uhigh() != f ? (v.uhigh() < f ? -1 : 1) :
+                p_compareNarrow(v.ulow(), x, fill);
+    }
+
+    // v op= x in place, x of any width. A narrower x is not promoted,
+    // a wider one is truncated to the width of v
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (size2 < size1)>
+    p_addInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        // negative x is subtracted by magnitude instead of sign-extended
+        if (x.isNegative()) {
+            p_subNarrow(v, Integer<size2, false>(-x));
+        } else {
+            p_addNarrow(v, Integer<size2, false>(x));
         }
+    }
 
-        template<size_t size>
-        constexpr inline Integer<size, false> div_ten_const() noexcept {
-            return div_ten_const_h<size>(p_i_seq::make_array<size_t, 0, size>());
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, size2 == size1>
+    p_addInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        p_addCarry(v, x, false);
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (size2 > size1)>
+    p_addInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        p_addCarry(v, Integer<size1, false>(x), false);
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (size2 < size1)>
+    p_subInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        if (x.isNegative()) {
+            p_addNarrow(v, Integer<size2, false>(-x));
+        } else {
+            p_subNarrow(v, Integer<size2, false>(x));
+        }
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, size2 == size1>
+    p_subInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        p_subCarry(v, x, false);
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (size2 > size1)>
+    p_subInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        p_subCarry(v, Integer<size1, false>(x), false);
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, p_intType(size1) == native>
+    p_mulInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        v = v * Integer<size1, sig1>(x);
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (p_intType(size1) == pow2) &&
+    (p_intType(size2) == native) >
+    p_mulInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        // a single mul-by-limb pass
+        bool neg = x.isNegative();
+        p_i_limbs::array_t<size1> tmp{};
+        p_storeLimbs(v, tmp, 0);
+        p_i_limbs::mul_1(tmp, p_i_limbs::L(Integer<size2, false>(neg ? -x : x)));
+        p_loadLimbs(v, tmp, 0);
+        if (neg) {
+            v = -v;
+        }
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (p_intType(size1) == pow2) &&
+    (p_intType(size2) == pow2) && (size2 < size1) >
+    p_mulInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        bool neg = x.isNegative();
+        p_i_limbs::array_t<size1> tmp{};
+        p_i_limbs::array_t<size2> y{};
+        p_storeLimbs(v, tmp, 0);
+        p_storeLimbs(Integer<size2, false>(neg ? -x : x), y, 0);
+        p_i_limbs::mul_n(tmp, y);
+        p_loadLimbs(v, tmp, 0);
+        if (neg) {
+            v = -v;
+        }
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline ct::if_t<void, (p_intType(size1) == pow2) &&
+    (size2 >= size1) >
+    p_mulInPlace(Integer<size1, sig1> &v, const Integer<size2, sig2> &x) noexcept {
+        // the scratch is bounded by the width of v
+        p_i_limbs::array_t<size1> tmp{};
+        p_i_limbs::array_t<size1> y{};
+        p_storeLimbs(v, tmp, 0);
+        p_storeLimbs(Integer<size1, false>(x), y, 0);
+        p_i_limbs::mul_n(tmp, y);
+        p_loadLimbs(v, tmp, 0);
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<void, p_intType(size) == native>
+    p_shiftLeftInPlace(Integer<size, sig> &v, size_t shift) noexcept {
+        v = v << shift;
+    }
+
+    // the limb move and funnel shift of p_i_limbs::shl on the limbs of v
+    // itself, one move by d limbs for each bit d of k, all from the top
+    template<size_t d, size_t size, bool sig, size_t... i>
+    constexpr inline ct::if_t<void, (d >= sizeof...(i))>
+    p_shlLimbs(Integer<size, sig> &v, size_t, size_t s,
+            p_i_seq::array_t<size_t, i...>) noexcept {
+        using p_i_seq::signed_size_t;
+        constexpr size_t n = sizeof...(i);
+        p_i_seq::unused_array({(p_limbAt<n - 1 - i>(v) = p_i_limbs::shld(
+                p_limbAt<n - 1 - i>(v),
+                p_limbOr<signed_size_t(n - 1 - i) - 1>(v, 0), s))...});
+    }
+
+    template<size_t d, size_t size, bool sig, size_t... i>
+    constexpr inline ct::if_t<void, (d < sizeof...(i))>
+    p_shlLimbs(Integer<size, sig> &v, size_t k, size_t s,
+            p_i_seq::array_t<size_t, i...> seq) noexcept {
+        using p_i_seq::signed_size_t;
+        using L = p_i_limbs::L;
+        constexpr size_t n = sizeof...(i);
+        const L m = -L((k & d) != 0);
+        p_i_seq::unused_array({(p_limbAt<n - 1 - i>(v) =
+                (p_limbOr<signed_size_t(n - 1 - i) - signed_size_t(d)>(v, 0) & m) |
+                (p_limbAt<n - 1 - i>(v) & ~m))...});
+        p_shlLimbs<d * 2>(v, k, s, seq);
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<void, p_intType(size) == pow2>
+    p_shiftLeftInPlace(Integer<size, sig> &v, size_t shift) noexcept {
+        shift &= size * p_i_native::min_native_bits - 1;
+        p_shlLimbs<1>(v, shift / p_i_limbs::limb_bits, shift & p_i_limbs::limb_mask,
+                p_i_seq::make_array<size_t, 0, p_i_limbs::count<size>()>());
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<void, p_intType(size) == native>
+    p_shiftRightInPlace(Integer<size, sig> &v, size_t shift) noexcept {
+        v = v >> shift;
+    }
+
+    // as p_shlLimbs for p_i_limbs::shr, all from the bottom
+    template<size_t d, size_t size, bool sig, size_t... i>
+    constexpr inline ct::if_t<void, (d >= sizeof...(i))>
+    p_shrLimbs(Integer<size, sig> &v, size_t, size_t s, p_i_limbs::L fill,
+            p_i_seq::array_t<size_t, i...>) noexcept {
+        using p_i_seq::signed_size_t;
+        p_i_seq::unused_array({(p_limbAt<i>(v) = p_i_limbs::shrd(
+                p_limbOr<signed_size_t(i) + 1>(v, fill), p_limbAt<i>(v), s))...});
+    }
+
+    template<size_t d, size_t size, bool sig, size_t... i>
+    constexpr inline ct::if_t<void, (d < sizeof...(i))>
+    p_shrLimbs(Integer<size, sig> &v, size_t k, size_t s, p_i_limbs::L fill,
+            p_i_seq::array_t<size_t, i...> seq) noexcept {
+        using p_i_seq::signed_size_t;
+        using L = p_i_limbs::L;
+        const L m = -L((k & d) != 0);
+        p_i_seq::unused_array({(p_limbAt<i>(v) =
+                (p_limbOr<signed_size_t(i + d)>(v, fill) & m) |
+                (p_limbAt<i>(v) & ~m))...});
+        p_shrLimbs<d * 2>(v, k, s, fill, seq);
+    }
+
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<void, p_intType(size) == pow2>
+    p_shiftRightInPlace(Integer<size, sig> &v, size_t shift) noexcept {
+        shift &= size * p_i_native::min_native_bits - 1;
+        p_shrLimbs<1>(v, shift / p_i_limbs::limb_bits, shift & p_i_limbs::limb_mask,
+                -p_i_limbs::L(v.isNegative()),
+                p_i_seq::make_array<size_t, 0, p_i_limbs::count<size>()>());
+    }
+
+    // R(a) op R(b) for a wide pow2 a and a narrower b, b is not promoted
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_addMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept {
+        R out = a;
+        p_addInPlace(out, b);
+        return out;
+    }
+
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_subMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept {
+        R out = a;
+        p_subInPlace(out, b);
+        return out;
+    }
+
+    template<typename R, size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline R
+    p_mulMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept {
+        R out = a;
+        p_mulInPlace(out, b);
+        return out;
+    }
+
+    template<size_t size1, bool sig1, size_t size2, bool sig2>
+    constexpr inline int
+    p_compareMixed(const Integer<size1, sig1> &a,
+            const Integer<size2, sig2> &b) noexcept {
+        bool an = a.isNegative(), bn = b.isNegative();
+        if (sig1 && (an != bn)) {
+            return an ? -1 : 1;
+        }
+        // same signs, two's complement patterns compare as unsigned
+        return p_compareNarrow(Integer<size1, false>(a),
+                Integer<size2, false>(b), bn);
+    }
+
+    // divides by a native divisor limb by limb, O(limbs) instead of O(bits)
+    template<size_t size>
+    constexpr inline ct::if_t<Integer<size, false>, p_intType(size) == pow2>
+    p_udivrem_n(const Integer<size, false> &x, p_i_limbs::L d,
+            p_i_limbs::L *rem) noexcept {
+        p_i_limbs::array_t<size> tmp{};
+        p_storeLimbs(x, tmp, 0);
+        p_i_limbs::L r = p_i_limbs::divrem_1(tmp, d);
+        if (rem) {
+            *rem = r;
+        }
+        Integer<size, false> q = Integer<size, false>::ZERO();
+        p_loadLimbs(q, tmp, 0);
+        return q;
+    }
+
+    template<typename R, size_t size1, bool sig1, typename T>
+    constexpr inline ct::if_t<R, (p_intType(size1) == pow2) &&
+    (sizeof (T) <= p_i_native::max_native_size) >
+    p_divrem_n(const Integer<size1, sig1> &v1, const T v2, R *rem) noexcept {
+        bool yNeg = ct::is_signed<T>() &&
+                Integer<sizeof (T), ct::is_signed<T>()>(v2).isNegative();
+        if (yNeg && !sig1) {
+            // negative divisor is converted to a huge unsigned value
+            if (rem) {
+                *rem = R(v1) % R(v2);
+            }
+            return R(v1) / R(v2);
+        }
+        bool xNeg = v1.isNegative();
+        p_i_limbs::L d = yNeg ? 0 - p_i_limbs::L(v2) : p_i_limbs::L(v2);
+        p_i_limbs::L r = 0;
+        R q = p_udivrem_n(Integer<size1, false>(xNeg ? -v1 : v1), d, &r);
+        if (rem) {
+            *rem = xNeg ? -R(r) : R(r);
+        }
+        return xNeg != yNeg ? -q : q;
+    }
+
+    template<typename R, size_t size1, bool sig1, typename T>
+    constexpr inline ct::if_t<R, !((p_intType(size1) == pow2) &&
+    (sizeof (T) <= p_i_native::max_native_size)) >
+    p_divrem_n(const Integer<size1, sig1> &v1, const T v2, R *rem) noexcept {
+        if (rem) {
+            *rem = R(v1) % R(v2);
+        }
+        return R(v1) / R(v2);
+    }
+
+    template<size_t size, typename T>
+    constexpr inline ct::if_int_t<Integer<size, false>, T, !ct::is_signed<T>() &&
+    (sizeof (T) <= p_i_native::max_native_size) && (p_intType(size) == pow2) >
+    divrem(const Integer<size, false> &x, const T y, T *rem) noexcept {
+        p_i_limbs::L r = 0;
+        Integer<size, false> q = p_udivrem_n(x, y, &r);
+        if (rem) {
+            *rem = T(r);
+        }
+        return q;
+    }
+
+    template<size_t size, typename T>
+    constexpr inline ct::if_int_t<Integer<size, false>, T, !ct::is_signed<T>() &&
+    (p_intType(size) == native) >
+    divrem(const Integer<size, false> &x, const T y, T *rem) noexcept {
+        if (rem) {
+            *rem = T(x % y);
         }
+        return Integer<size, false>(x / y);
+    }
+
+#if INTEGER_HPP_HAS_OSTREAM
+    namespace p_i_print {
 
         template<size_t size>
         constexpr inline ct::if_t<unsigned, p_intType(size) == native>
@@ -2480,10 +4210,9 @@ namespace JIO {
         template<size_t size>
         constexpr inline ct::if_t<unsigned, p_intType(size) == pow2>
         divremTen(Integer<size, false> &v) noexcept {
-            constexpr Integer<size, false> dc = div_ten_const<size>();
-            unsigned tmp = unsigned(v);
-            v = wmultiply(v, dc).uhigh() >> 3;
-            return tmp - unsigned(v) * 10;
+            p_i_limbs::L rem = 0;
+            v = p_udivrem_n(v, 10, &rem);
+            return unsigned(rem);
         }
 
         constexpr inline size_t p_digits10(size_t size, bool sig) noexcept {
@@ -2590,27 +4319,29 @@ namespace JIO {
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator+(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        return R(v1) + R(v2);
+        return v1 + Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T,
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator+(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        return R(v1) + R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) + v2;
     }
 
     template<size_t size1, bool sig1, size_t size2, bool sig2>
     constexpr inline Integer<size1, sig1>&
     operator+=(Integer<size1, sig1> &v1,
             const Integer<size2, sig2> &v2) noexcept {
-        return v1 = (v1 + Integer<size1, sig1>(v2));
+        p_addInPlace(v1, v2);
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<Integer<size1, sig1>&, T>
     operator+=(Integer<size1, sig1> &v1, const T v2) noexcept {
-        return v1 = (v1 + Integer<size1, sig1>(v2));
+        p_addInPlace(v1, Integer<sizeof (T), ct::is_signed<T>()>(v2));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2624,27 +4355,29 @@ namespace JIO {
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator-(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        return R(v1) - R(v2);
+        return v1 - Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T,
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator-(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        return R(v1) - R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) - v2;
     }
 
     template<size_t size1, bool sig1, size_t size2, bool sig2>
     constexpr inline Integer<size1, sig1>&
     operator-=(Integer<size1, sig1> &v1,
             const Integer<size2, sig2> &v2) noexcept {
-        return v1 = (v1 - Integer<size1, sig1>(v2));
+        p_subInPlace(v1, v2);
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<Integer<size1, sig1>&, T>
     operator-=(Integer<size1, sig1> &v1, const T v2) noexcept {
-        return v1 = (v1 - Integer<size1, sig1>(v2));
+        p_subInPlace(v1, Integer<sizeof (T), ct::is_signed<T>()>(v2));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2658,27 +4391,29 @@ namespace JIO {
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator*(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        return R(v1) * R(v2);
+        return v1 * Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T,
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator*(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        return R(v1) * R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) * v2;
     }
 
     template<size_t size1, bool sig1, size_t size2, bool sig2>
     constexpr inline Integer<size1, sig1>&
     operator*=(Integer<size1, sig1> &v1,
             const Integer<size2, sig2> &v2) noexcept {
-        return v1 = (v1 * Integer<size1, sig1>(v2));
+        p_mulInPlace(v1, v2);
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<Integer<size1, sig1>&, T>
     operator*=(Integer<size1, sig1> &v1, const T v2) noexcept {
-        return v1 = (v1 * Integer<size1, sig1>(v2));
+        p_mulInPlace(v1, Integer<sizeof (T), ct::is_signed<T>()>(v2));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2692,7 +4427,7 @@ namespace JIO {
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator/(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        return R(v1) / R(v2);
+        return p_divrem_n<R>(v1, v2, (R*) nullptr);
     }
 
     template<size_t size1, bool sig1, typename T,
@@ -2725,7 +4460,9 @@ namespace JIO {
     typename R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>>
     constexpr inline ct::if_int_t<R, T>
     operator%(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        return R(v1) % R(v2);
+        R rem = R::ZERO();
+        p_divrem_n<R>(v1, v2, &rem);
+        return rem;
     }
 
     template<size_t size1, bool sig1, typename T,
@@ -2859,85 +4596,73 @@ namespace JIO {
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator==(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) == R(v2);
+        return v1 == Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator==(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) == R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) == v2;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator!=(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) != R(v2);
+        return v1 != Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator!=(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) != R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) != v2;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator<=(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) <= R(v2);
+        return v1 <= Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator<=(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) <= R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) <= v2;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator>=(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) >= R(v2);
+        return v1 >= Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator>=(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) >= R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) >= v2;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator<(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) < R(v2);
+        return v1 < Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator<(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) < R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) < v2;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator>(const Integer<size1, sig1> &v1, const T v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) > R(v2);
+        return v1 > Integer<sizeof (T), ct::is_signed<T>()>(v2);
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<bool, T>
     operator>(const T v1, const Integer<size1, sig1> &v2) noexcept {
-        using R = result_t<size1, sizeof (T), sig1, ct::is_signed<T>()>;
-        return R(v1) > R(v2);
+        return Integer<sizeof (T), ct::is_signed<T>()>(v1) > v2;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2951,13 +4676,15 @@ namespace JIO {
     constexpr inline Integer<size1, sig1>&
     operator<<=(Integer<size1, sig1> &v1,
             const Integer<size2, sig2> &v2) noexcept {
-        return v1 = (v1 << v2);
+        p_shiftLeftInPlace(v1, size_t(p_SHType<size1>(v2)));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<Integer<size1, sig1>&, T>
     operator<<=(Integer<size1, sig1> &v1, const T v2) noexcept {
-        return v1 = (v1 << v2);
+        p_shiftLeftInPlace(v1, size_t(p_SHType<size1>(v2)));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2977,13 +4704,15 @@ namespace JIO {
     constexpr inline Integer<size1, sig1>&
     operator>>=(Integer<size1, sig1> &v1,
             const Integer<size2, sig2> &v2) noexcept {
-        return v1 = (v1 >> v2);
+        p_shiftRightInPlace(v1, size_t(p_SHType<size1>(v2)));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
     constexpr inline ct::if_int_t<Integer<size1, sig1>&, T>
     operator>>=(Integer<size1, sig1> &v1, const T v2) noexcept {
-        return v1 = (v1 >> v2);
+        p_shiftRightInPlace(v1, size_t(p_SHType<size1>(v2)));
+        return v1;
     }
 
     template<size_t size1, bool sig1, typename T>
@@ -2992,6 +4721,2132 @@ namespace JIO {
         return v1 = T(Integer<sizeof (T), ct::is_signed<T>()>(v1) >> v2);
     }
 
+    template<size_t size, bool sig, size_t N>
+    class p_lazy_expr;
+
+    template<size_t size>
+    constexpr inline bool p_lazy_enabled() noexcept {
+        return (size == p_i_native::max_native_size) ||
+                (p_intType(size) == pow2);
+    }
+
+    // adds a * b (or a when b is null) to pos or negs, signed operands are
+    // taken by magnitude and the sign of the term picks the accumulator
+    template<size_t size, bool sig, size_t m>
+    constexpr inline void
+    p_accumulate(p_i_seq::v_array_t<p_i_limbs::L, m> &pos,
+            p_i_seq::v_array_t<p_i_limbs::L, m> &negs,
+            const Integer<size, sig> &a, const Integer<size, sig> *b,
+            bool neg) noexcept {
+        using UI = Integer<size, false>;
+        bool n = neg != a.isNegative();
+        p_i_limbs::array_t<size> x{};
+        p_storeLimbs(UI(a.isNegative() ? -a : a), x, 0);
+        if (b) {
+            n = n != b->isNegative();
+            p_i_limbs::array_t<size> y{};
+            p_storeLimbs(UI(b->isNegative() ? -*b : *b), y, 0);
+            p_i_limbs::addmul_n(n ? negs : pos, x, y);
+        } else {
+            p_i_limbs::add_n(n ? negs : pos, x);
+        }
+    }
+
+    // Sum of N terms, each one is an operand or a product of two operands,
+    // added or subtracted. Evaluation accumulates all products into one limb
+    // array (positive and negative terms separately) and reduces once.
+    // Only references to the operands are held, so an expression must be
+    // evaluated within the full expression it was made in
+    template<size_t size, bool sig, size_t N>
+    class p_lazy_expr {
+    private:
+        using I = Integer<size, sig>;
+
+        const I *left[N] = {};
+        const I *right[N] = {};
+        bool neg[N] = {};
+
+        template<size_t, bool, size_t>
+        friend class p_lazy_expr;
+
+    public:
+
+        constexpr inline p_lazy_expr(const I *a, const I *b, bool n) noexcept {
+            left[0] = a;
+            right[0] = b;
+            neg[0] = n;
+        }
+
+        template<size_t M>
+        constexpr inline p_lazy_expr(const p_lazy_expr<size, sig, M> &a,
+                const p_lazy_expr<size, sig, N - M> &b, bool negb) noexcept {
+            for (size_t i = 0; i < M; i++) {
+                left[i] = a.left[i];
+                right[i] = a.right[i];
+                neg[i] = a.neg[i];
+            }
+            for (size_t i = 0; i < N - M; i++) {
+                left[M + i] = b.left[i];
+                right[M + i] = b.right[i];
+                neg[M + i] = b.neg[i] != negb;
+            }
+        }
+
+        constexpr inline p_lazy_expr operator-() const noexcept {
+            p_lazy_expr out = *this;
+            for (size_t i = 0; i < N; i++) {
+                out.neg[i] = !neg[i];
+            }
+            return out;
+        }
+
+        template<size_t M>
+        constexpr inline p_lazy_expr<size, sig, N + M>
+        operator+(const p_lazy_expr<size, sig, M> &other) const noexcept {
+            return p_lazy_expr<size, sig, N + M>(*this, other, false);
+        }
+
+        template<size_t M>
+        constexpr inline p_lazy_expr<size, sig, N + M>
+        operator-(const p_lazy_expr<size, sig, M> &other) const noexcept {
+            return p_lazy_expr<size, sig, N + M>(*this, other, true);
+        }
+
+        constexpr inline p_lazy_expr<size, sig, N + 1>
+        operator+(const I &other) const noexcept {
+            return *this + p_lazy_expr<size, sig, 1>(&other, nullptr, false);
+        }
+
+        constexpr inline p_lazy_expr<size, sig, N + 1>
+        operator-(const I &other) const noexcept {
+            return *this + p_lazy_expr<size, sig, 1>(&other, nullptr, true);
+        }
+
+        // init + expression, computed modulo 2^(size2 * 8)
+        template<size_t size2>
+        constexpr inline ct::if_t<Integer<size2, sig>, (size2 == size) ||
+        (size2 == size * 2) >
+        evaluate(const Integer<size2, sig> &init) const noexcept {
+            p_i_limbs::array_t<size2> pos{}, negs{};
+            p_storeLimbs(init, pos, 0);
+            for (size_t i = 0; i < N; i++) {
+                p_accumulate(pos, negs, *left[i], right[i], neg[i]);
+            }
+            p_i_limbs::sub_n(pos, negs);
+            Integer<size2, sig> out = Integer<size2, sig>::ZERO();
+            p_loadLimbs(out, pos, 0);
+            return out;
+        }
+
+        constexpr inline operator I() const noexcept {
+            return evaluate(I::ZERO());
+        }
+
+        // exact result of a multiply-accumulate
+        constexpr inline operator Integer<size * 2, sig>() const noexcept {
+            return evaluate(Integer<size * 2, sig>::ZERO());
+        }
+    };
+
+    // a single operand, the only term that can be multiplied
+    template<size_t size, bool sig>
+    class p_lazy_value : public p_lazy_expr<size, sig, 1> {
+    private:
+        using I = Integer<size, sig>;
+
+        const I *v;
+
+    public:
+
+        constexpr explicit inline p_lazy_value(const I &v) noexcept :
+        p_lazy_expr<size, sig, 1>(&v, nullptr, false), v(&v) { }
+
+        constexpr inline p_lazy_expr<size, sig, 1>
+        operator*(const I &other) const noexcept {
+            return p_lazy_expr<size, sig, 1>(v, &other, false);
+        }
+    };
+
+    // opt-in fused evaluation: lazy(a) * b + lazy(c) * d - e
+    template<size_t size, bool sig>
+    constexpr inline ct::if_t<p_lazy_value<size, sig>, p_lazy_enabled<size>()>
+    lazy(const Integer<size, sig> &v) noexcept {
+        return p_lazy_value<size, sig>(v);
+    }
+
+    template<size_t size, bool sig, size_t N>
+    constexpr inline p_lazy_expr<size, sig, N + 1>
+    operator+(const Integer<size, sig> &v,
+            const p_lazy_expr<size, sig, N> &e) noexcept {
+        return lazy(v) + e;
+    }
+
+    template<size_t size, bool sig, size_t N>
+    constexpr inline p_lazy_expr<size, sig, N + 1>
+    operator-(const Integer<size, sig> &v,
+            const p_lazy_expr<size, sig, N> &e) noexcept {
+        return lazy(v) - e;
+    }
+
+    template<size_t size, size_t size2, bool sig, size_t N>
+    constexpr inline ct::if_t<Integer<size2, sig>&, (size2 == size) ||
+    (size2 == size * 2) >
+    operator+=(Integer<size2, sig> &v, const p_lazy_expr<size, sig, N> &e) noexcept {
+        return v = e.evaluate(v);
+    }
+
+    template<size_t size, size_t size2, bool sig, size_t N>
+    constexpr inline ct::if_t<Integer<size2, sig>&, (size2 == size) ||
+    (size2 == size * 2) >
+    operator-=(Integer<size2, sig> &v, const p_lazy_expr<size, sig, N> &e) noexcept {
+        return v = (-e).evaluate(v);
+    }
+
+    // a * b + c, exact in the double width
+    template<size_t size, bool sig, size_t size2,
+    typename R = Integer<size * 2, sig>>
+    constexpr inline ct::if_t<R, ((size2 == size) || (size2 == size * 2)) &&
+    p_lazy_enabled<size>() >
+    fma(const Integer<size, sig> &a, const Integer<size, sig> &b,
+            const Integer<size2, sig> &c) noexcept {
+        return (lazy(a) * b).evaluate(R(c));
+    }
+
+    template<size_t size, bool sig, size_t size2,
+    typename R = Integer<size * 2, sig>>
+    constexpr inline ct::if_t<R, ((size2 == size) || (size2 == size * 2)) &&
+    !p_lazy_enabled<size>() >
+    fma(const Integer<size, sig> &a, const Integer<size, sig> &b,
+            const Integer<size2, sig> &c) noexcept {
+        return wmultiply(a, b) + R(c);
+    }
+
+    // sum of a[i] * b[i], exact modulo 2^(sizeof (T) * 16)
+    template<typename T, typename R = Integer<sizeof (T) * 2, ct::is_signed<T>()>>
+    constexpr inline ct::if_int_t<R, T, sizeof (T) == p_i_native::max_native_size>
+    dot(const T *a, const T *b, size_t n) noexcept {
+        using L = p_i_limbs::L;
+        // carry-save, the carries out of the low words are counted and
+        // added to the high word once at the end
+        L low = 0, high = 0, carries = 0;
+        for (size_t i = 0; i < n; i++) {
+            L x = L(a[i]), y = L(b[i]);
+            L h = 0;
+            L l = p_i_limbs::mul(x, y, h);
+            if (ct::is_signed<T>()) {
+                // signed product from the unsigned one
+                h -= (-(x >> p_i_limbs::limb_mask) & y) +
+                        (-(y >> p_i_limbs::limb_mask) & x);
+            }
+            low += l;
+            carries += low < l;
+            high += h;
+        }
+        using U = Integer<sizeof (T), false>;
+        return R(Integer<sizeof (T) * 2, false>(U(low), U(high + carries)));
+    }
+
+    template<typename T, typename R = Integer<sizeof (T) * 2, ct::is_signed<T>()>>
+    constexpr inline ct::if_int_t<R, T, sizeof (T) < p_i_native::max_native_size>
+    dot(const T *a, const T *b, size_t n) noexcept {
+        // the products fit in the double width native type
+        using W = p_i_native::native_int_type<sizeof (T) * 2, ct::is_signed<T>()>;
+        using UW = p_i_native::native_int_type<sizeof (T) * 2, false>;
+        UW out = 0;
+        for (size_t i = 0; i < n; i++) {
+            out += UW(W(a[i]) * W(b[i]));
+        }
+        return R(Integer<sizeof (T) * 2, false>(out));
+    }
+
+    template<size_t size, bool sig, typename R = Integer<size * 2, sig>>
+    constexpr inline ct::if_t<R, p_lazy_enabled<size>()>
+    dot(const Integer<size, sig> *a, const Integer<size, sig> *b,
+            size_t n) noexcept {
+        p_i_limbs::array_t<size * 2> pos{}, negs{};
+        for (size_t i = 0; i < n; i++) {
+            p_accumulate(pos, negs, a[i], &b[i], false);
+        }
+        p_i_limbs::sub_n(pos, negs);
+        R out = R::ZERO();
+        p_loadLimbs(out, pos, 0);
+        return out;
+    }
+
+    template<size_t size, bool sig, typename R = Integer<size * 2, sig>>
+    constexpr inline ct::if_t<R, !p_lazy_enabled<size>()>
+    dot(const Integer<size, sig> *a, const Integer<size, sig> *b,
+            size_t n) noexcept {
+        R out = R::ZERO();
+        for (size_t i = 0; i < n; i++) {
+            out += wmultiply(a[i], b[i]);
+        }
+        return out;
+    }
+
+    // binary gcd, for the widths where a division costs much more
+    // than a few shifts and subtractions
+    template<size_t size>
+    constexpr inline Integer<size, false>
+    p_gcdBinary(Integer<size, false> a, Integer<size, false> b) noexcept {
+        if (a.isZero()) {
+            return b;
+        }
+        if (b.isZero()) {
+            return a;
+        }
+        const size_t k = (a | b).numberOfTrailingZeros();
+        a >>= a.numberOfTrailingZeros();
+        do {
+            b >>= b.numberOfTrailingZeros();
+            if (a > b) {
+                Integer<size, false> tmp = a;
+                a = b;
+                b = tmp;
+            }
+            b -= a;
+        } while (!b.isZero());
+        return a << k;
+    }
+
+    // Lehmer's gcd of a >= b, Knuth vol. 2, 4.5.2, Algorithm L. Euclid's
+    // steps are done on the leading bits in single words while their
+    // quotients match the ones of the full values, then applied to a and
+    // b at once. If x (y) is not null, it is set to the cofactor of a (b)
+    // in gcd = a * x + b * y modulo 2^(size * 8)
+    template<size_t size>
+    constexpr inline Integer<size, false>
+    p_gcdLehmer(Integer<size, false> a, Integer<size, false> b,
+            Integer<size, false> *x, Integer<size, false> *y) noexcept {
+        using UI = Integer<size, false>;
+        using S = p_i_native::native_int_type<p_i_native::max_native_size, true>;
+        using SI = Integer<p_i_native::max_native_size, true>;
+        // with this many leading bits the cofactors and the quotients
+        // fit in a signed word
+        constexpr size_t p = p_i_limbs::limb_bits - 2;
+        // a = ua * a0 + va * b0, b = ub * a0 + vb * b0
+        UI ua = UI(1U), va = UI::ZERO(), ub = UI::ZERO(), vb = UI(1U);
+        while (!b.isZero()) {
+            const size_t n = size * 8 - a.numberOfLeadingZeros();
+            const size_t s = n > p ? n - p : 0;
+            S xh = S(p_i_limbs::L(a >> s)), yh = S(p_i_limbs::L(b >> s));
+            S A = 1, B = 0, C = 0, D = 1;
+            while (yh + C != 0 && yh + D != 0) {
+                S q = (xh + A) / (yh + C);
+                if (q != (xh + B) / (yh + D)) {
+                    break;
+                }
+                S t = A - q * C;
+                A = C;
+                C = t;
+                t = B - q * D;
+                B = D;
+                D = t;
+                t = xh - q * yh;
+                xh = yh;
+                yh = t;
+            }
+            if (B == 0) {
+                // the leading bits give no quotient, a full division step
+                UI r = UI::ZERO();
+                UI q = divrem(a, b, &r);
+                a = b;
+                b = r;
+                if (x) {
+                    UI t = ua - q * ub;
+                    ua = ub;
+                    ub = t;
+                }
+                if (y) {
+                    UI t = va - q * vb;
+                    va = vb;
+                    vb = t;
+                }
+            } else {
+                UI t = UI(a * SI(A) + b * SI(B));
+                b = UI(a * SI(C) + b * SI(D));
+                a = t;
+                if (x) {
+                    t = UI(ua * SI(A) + ub * SI(B));
+                    ub = UI(ua * SI(C) + ub * SI(D));
+                    ua = t;
+                }
+                if (y) {
+                    t = UI(va * SI(A) + vb * SI(B));
+                    vb = UI(va * SI(C) + vb * SI(D));
+                    va = t;
+                }
+            }
+        }
+        if (x) {
+            *x = ua;
+        }
+        if (y) {
+            *y = va;
+        }
+        return a;
+    }
+
+    template<size_t size>
+    constexpr inline ct::if_t<Integer<size, false>, (size <= 16) >
+    p_gcd(const Integer<size, false> &a, const Integer<size, false> &b) noexcept {
+        return p_gcdBinary(a, b);
+    }
+
+    template<size_t size>
+    constexpr inline ct::if_t<Integer<size, false>, (size > 16) >
+    p_gcd(const Integer<size, false> &a, const Integer<size, false> &b) noexcept {
+        return a < b ? p_gcdLehmer(b, a, (Integer<size, false>*)nullptr,
+                (Integer<size, false>*)nullptr) :
+                p_gcdLehmer(a, b, (Integer<size, false>*)nullptr,
+                (Integer<size, false>*)nullptr);
+    }
+
+    // the result is not negative
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig>
+    gcd(const Integer<size, sig> &a, const Integer<size, sig> &b) noexcept {
+        using UI = Integer<size, false>;
+        return Integer<size, sig>(p_gcd(UI(a.isNegative() ? -a : a),
+                UI(b.isNegative() ? -b : b)));
+    }
+
+    // the result is not negative, modulo 2^(size * 8)
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig>
+    lcm(const Integer<size, sig> &a, const Integer<size, sig> &b) noexcept {
+        using UI = Integer<size, false>;
+        UI x = a.isNegative() ? -a : a;
+        UI y = b.isNegative() ? -b : b;
+        if (x.isZero() || y.isZero()) {
+            return Integer<size, sig>::ZERO();
+        }
+        return Integer<size, sig>(x / p_gcd(x, y) * y);
+    }
+
+    // gcd(a, b) = a * x + b * y, the cofactors are the ones of Euclid's
+    // algorithm, |x| <= |b| / 2 and |y| <= |a| / 2. x and y may be null
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig>
+    xgcd(const Integer<size, sig> &a, const Integer<size, sig> &b,
+            ct::no_deduce_t<Integer<size, true>> *x,
+            ct::no_deduce_t<Integer<size, true>> *y) noexcept {
+        using UI = Integer<size, false>;
+        UI ua = a.isNegative() ? -a : a;
+        UI ub = b.isNegative() ? -b : b;
+        UI cx = UI::ZERO(), cy = UI::ZERO();
+        const bool swap = ua < ub;
+        UI g = swap ? p_gcdLehmer(ub, ua, y ? &cy : nullptr, x ? &cx : nullptr) :
+                p_gcdLehmer(ua, ub, x ? &cx : nullptr, y ? &cy : nullptr);
+        if (x) {
+            *x = a.isNegative() ? -Integer<size, true>(cx) : Integer<size, true>(cx);
+        }
+        if (y) {
+            *y = b.isNegative() ? -Integer<size, true>(cy) : Integer<size, true>(cy);
+        }
+        return Integer<size, sig>(g);
+    }
+
+    // a * x = 1 (mod m), zero if there is no inverse
+    template<size_t size>
+    constexpr inline Integer<size, false>
+    modinv(const Integer<size, false> &a, const Integer<size, false> &m) noexcept {
+        using UI = Integer<size, false>;
+        UI v = UI::ZERO();
+        UI g = p_gcdLehmer(m, a < m ? a : a % m, (UI*)nullptr, &v);
+        if (g != 1U) {
+            return UI::ZERO();
+        }
+        // |v| < m
+        return Integer<size, true>(v).isNegative() ? v + m : v;
+    }
+
+    // y / d mod 2^(size * 8) for an odd d
+    template<size_t size, bool sig, typename I = Integer<size, sig> >
+    constexpr inline ct::if_t<I, p_intType(size) == native>
+    p_bdiv(const Integer<size, sig> &y, const Integer<size, sig> &d) noexcept {
+        using UI = Integer<size, false>;
+        return I(UI(y) * UI(p_i_limbs::binvert(p_i_limbs::L(d.uvalue()))));
+    }
+
+    template<size_t size, bool sig, typename I = Integer<size, sig> >
+    constexpr inline ct::if_t<I, p_intType(size) == pow2>
+    p_bdiv(const Integer<size, sig> &y, const Integer<size, sig> &d) noexcept {
+        p_i_limbs::array_t<size> a{}, b{}, q{};
+        p_storeLimbs(y, a, 0);
+        p_storeLimbs(d, b, 0);
+        p_i_limbs::bdiv(q, a, b, p_i_limbs::binvert(b[0]));
+        I out = I::ZERO();
+        p_loadLimbs(out, q, 0);
+        return out;
+    }
+
+    // x / d when d divides x, without a long division: with d = d' * 2^s
+    // and an odd d', x >> s times the inverse of d' modulo 2^(size * 8).
+    // d must not be zero, the result is meaningless when d does not
+    // divide x
+    template<size_t size, bool sig>
+    constexpr inline Integer<size, sig>
+    divexact(const Integer<size, sig> &x, const Integer<size, sig> &d) noexcept {
+        const size_t s = d.numberOfTrailingZeros();
+        return p_bdiv(x >> s, d >> s);
+    }
+
+    // whether d divides x, zero only divides zero. The 2-adic quotient q of
+    // x >> s by the odd d' is the true one iff q * d' does not wrap
+    template<size_t size, bool sig>
+    constexpr inline bool
+    is_divisible(const Integer<size, sig> &x, const Integer<size, sig> &d) noexcept {
+        using UI = Integer<size, false>;
+        UI ux = x.isNegative() ? -x : x;
+        UI ud = d.isNegative() ? -d : d;
+        if (ux.isZero() || ud.isZero()) {
+            return ux.isZero();
+        }
+        const size_t s = ud.numberOfTrailingZeros();
+        if (ux.numberOfTrailingZeros() < s) {
+            return false;
+        }
+        ud >>= s;
+        UI q = p_bdiv(UI(ux >> s), ud);
+        // q * d' is in [2^(bits - 2), 2^bits)
+        const size_t bits = size * 16 - q.numberOfLeadingZeros() -
+                ud.numberOfLeadingZeros();
+        return bits <= size * 8 || (bits == size * 8 + 1 && mulhi(q, ud).isZero());
+    }
+
+
+    // Montgomery arithmetic modulo an odd m, R = 2^(size * 8). Values in
+    // Montgomery form are a * R mod m and stay below m
+    template<size_t size>
+    class Montgomery {
+        using I = Integer<size, false>;
+        using W = Integer<size * 2, false>;
+        using L = p_i_limbs::L;
+
+        static_assert(size % p_i_native::max_native_size == 0,
+                "size must be a multiple of the limb size");
+
+        I m;
+        p_i_limbs::array_t<size> limbs;
+        // R mod m and R^2 mod m
+        I r1, r2;
+        L minv;
+
+        constexpr static p_i_limbs::array_t<size> toLimbs(const I &v) noexcept {
+            p_i_limbs::array_t<size> out{};
+            p_storeLimbs(v, out, 0);
+            return out;
+        }
+
+    public:
+
+        constexpr explicit Montgomery(const I &mod) noexcept : m(mod),
+        limbs(toLimbs(mod)), r1((I::ZERO() - mod) % mod),
+        r2(I((W(r1) << (size * 8)) % W(mod))),
+        minv(-p_i_limbs::binvert(limbs[0])) { }
+
+        constexpr const I& modulus() const noexcept {
+            return m;
+        }
+
+        // 1 in Montgomery form
+        constexpr I one() const noexcept {
+            return r1;
+        }
+
+        // a * b / R mod m, a * b < m * R
+        constexpr I mul(const I &a, const I &b) const noexcept {
+            p_i_limbs::array_t<size * 2> t{};
+            p_i_limbs::addmul_n(t, toLimbs(a), toLimbs(b));
+            L top = p_i_limbs::redc(t, limbs, minv);
+            I out = I::ZERO();
+            p_loadLimbs(out, t, p_i_limbs::count<size>());
+            if (top || out >= m) {
+                out -= m;
+            }
+            return out;
+        }
+
+        constexpr I sqr(const I &a) const noexcept {
+            return mul(a, a);
+        }
+
+        constexpr I add(const I &a, const I &b) const noexcept {
+            I out = I::ZERO();
+            if (I::add_overflow(a, b, out) || out >= m) {
+                out -= m;
+            }
+            return out;
+        }
+
+        constexpr I sub(const I &a, const I &b) const noexcept {
+            return a < b ? a - b + m : a - b;
+        }
+
+        // any a < R to Montgomery form
+        constexpr I to(const I &a) const noexcept {
+            return mul(a, r2);
+        }
+
+        constexpr I from(const I &a) const noexcept {
+            return mul(a, I(1U));
+        }
+
+        // a^e, a and the result are in Montgomery form
+        template<size_t size2>
+        constexpr I pow(const I &a, const Integer<size2, false> &e) const noexcept {
+            I out = r1;
+            for (size_t i = size2 * 8 - e.numberOfLeadingZeros(); i-- > 0;) {
+                out = sqr(out);
+                if (e.getBit(i)) {
+                    out = mul(out, a);
+                }
+            }
+            return out;
+        }
+    };
+
+#if INTEGER_HPP_HAS_VECTOR
+
+    // Powers of a fixed base g modulo an odd m. The table holds
+    // g^(d * 2^(i * window)) in Montgomery form for every digit d > 0 of
+    // every window, so g^e is one multiplication per non zero digit of e
+    // and no squaring. It takes ceil(size * 8 / window) * (2^window - 1)
+    // values in a std::vector, window trades memory for multiplications
+    template<size_t size, size_t window = 4 >
+    class FixedBasePow {
+        using I = Integer<size, false>;
+
+        static_assert(window > 0 && window < 16, "wrong window");
+
+        constexpr static size_t rows = (size * 8 + window - 1) / window;
+        constexpr static size_t digits = (size_t(1) << window) - 1;
+
+        Montgomery<size> ctx;
+        std::vector<I> table;
+    public:
+
+        FixedBasePow(const I &g, const I &mod) : ctx(mod), table(rows * digits) {
+            // the base of each row is the last entry of the previous one
+            // times its base, g^(2^(i * window))
+            I base = ctx.to(g);
+            for (size_t i = 0; i < rows; i++) {
+                I v = base;
+                for (size_t d = 0; d < digits; d++) {
+                    table[i * digits + d] = v;
+                    v = ctx.mul(v, base);
+                }
+                base = v;
+            }
+        }
+
+        const I& modulus() const noexcept {
+            return ctx.modulus();
+        }
+
+        // g^e mod m
+        template<size_t size2>
+        I pow(const Integer<size2, false> &e) const noexcept {
+            static_assert(size2 <= size, "the exponent is too wide");
+            I out = ctx.one();
+            bool first = true;
+            const size_t bits = size2 * 8 - e.numberOfLeadingZeros();
+            for (size_t i = 0; i * window < bits; i++) {
+                size_t d = 0;
+                for (size_t j = window; j-- > 0;) {
+                    const size_t bit = i * window + j;
+                    d = d * 2 + (bit < bits && e.getBit(bit));
+                }
+                if (d != 0) {
+                    const I &v = table[i * digits + d - 1];
+                    out = first ? v : ctx.mul(out, v);
+                    first = false;
+                }
+            }
+            return ctx.from(out);
+        }
+    };
+#endif
+
+    // the bits [pos, pos + w) of e
+    template<size_t size>
+    constexpr inline size_t p_window(const Integer<size, false> &e,
+            size_t pos, size_t w) noexcept {
+        size_t d = 0;
+        for (size_t j = w; j-- > 0;) {
+            d = d * 2 + (pos + j < size * 8 && e.getBit(pos + j));
+        }
+        return d;
+    }
+
+    // the largest window up to w for which a table of n * (2^w - 1) values
+    // of size bytes stays within 16 KB
+    constexpr inline size_t p_tableWindow(size_t size, size_t n, size_t w) noexcept {
+        while (w > 1 && n * ((size_t(1) << w) - 1) * size > 16384) {
+            w--;
+        }
+        return w;
+    }
+
+    // Straus' interleaved windows, the squarings are shared and every base
+    // has its 2^w - 1 powers in table. Montgomery form
+    constexpr size_t p_straus_max = 16;
+
+    template<size_t size, size_t size2>
+    constexpr Integer<size, false> p_straus(const Montgomery<size> &ctx,
+            const Integer<size, false> *bases, const Integer<size2, false> *exps,
+            size_t n, size_t bits, size_t w, Integer<size, false> *table) noexcept {
+        using I = Integer<size, false>;
+        const size_t digits = (size_t(1) << w) - 1;
+        for (size_t i = 0; i < n; i++) {
+            const I b = ctx.to(bases[i]);
+            table[i * digits] = b;
+            for (size_t d = 1; d < digits; d++) {
+                table[i * digits + d] = ctx.mul(table[i * digits + d - 1], b);
+            }
+        }
+        I out = ctx.one();
+        for (size_t pos = (bits + w - 1) / w * w; pos > 0;) {
+            pos -= w;
+            for (size_t j = 0; j < w; j++) {
+                out = ctx.sqr(out);
+            }
+            for (size_t i = 0; i < n; i++) {
+                const size_t d = p_window(exps[i], pos, w);
+                if (d != 0) {
+                    out = ctx.mul(out, table[i * digits + d - 1]);
+                }
+            }
+        }
+        return out;
+    }
+
+    // the window of p_pippenger for n bases, about
+    // bits / w * (n + 2^(w + 1)) multiplications
+    constexpr inline size_t p_pippengerWindow(size_t n, size_t max_w) noexcept {
+        size_t w = 1;
+        for (size_t c = 2; c <= max_w; c++) {
+            if ((n + (size_t(2) << c)) * w < (n + (size_t(2) << w)) * c) {
+                w = c;
+            }
+        }
+        return w;
+    }
+
+    // Pippenger's buckets, for every window the bases are multiplied into
+    // the bucket of their digit, the 2^w - 1 buckets are then combined
+    // with two running products. The squarings are shared by all the
+    // bases. The bases are in Montgomery form if mont, otherwise each one
+    // is converted as it is put in its bucket
+    template<size_t size, size_t size2>
+    constexpr Integer<size, false> p_pippenger(const Montgomery<size> &ctx,
+            const Integer<size, false> *bases, const Integer<size2, false> *exps,
+            size_t n, size_t bits, bool mont, size_t w,
+            Integer<size, false> *buckets) noexcept {
+        using I = Integer<size, false>;
+        const size_t count = (size_t(1) << w) - 1;
+        I out = ctx.one();
+        for (size_t pos = (bits + w - 1) / w * w; pos > 0;) {
+            pos -= w;
+            for (size_t j = 0; j < w; j++) {
+                out = ctx.sqr(out);
+            }
+            for (size_t d = 0; d < count; d++) {
+                buckets[d] = ctx.one();
+            }
+            for (size_t i = 0; i < n; i++) {
+                const size_t d = p_window(exps[i], pos, w);
+                if (d != 0) {
+                    buckets[d - 1] = ctx.mul(buckets[d - 1],
+                            mont ? bases[i] : ctx.to(bases[i]));
+                }
+            }
+            // prod bucket_d^d = prod over d of (prod of the buckets >= d)
+            I running = ctx.one();
+            I sum = ctx.one();
+            for (size_t d = count; d-- > 0;) {
+                running = ctx.mul(running, buckets[d]);
+                sum = ctx.mul(sum, running);
+            }
+            out = ctx.mul(out, sum);
+        }
+        return out;
+    }
+
+    // prod bases[i]^exps[i] mod m for an odd m, the squarings are shared
+    // by all the powers. The tables are on the heap with
+    // INTEGER_HPP_HAS_VECTOR. Without it they are on the stack, with
+    // windows narrowed by size, and more than p_straus_max bases are
+    // converted to Montgomery form in every window
+    template<size_t size, size_t size2>
+    inline Integer<size, false> multi_powmod(const Integer<size, false> *bases,
+            const Integer<size2, false> *exps, size_t n,
+            const Integer<size, false> &m) {
+        using I = Integer<size, false>;
+        const Montgomery<size> ctx(m);
+        size_t bits = 0;
+        for (size_t i = 0; i < n; i++) {
+            bits = p_i_native::max(bits, size2 * 8 - exps[i].numberOfLeadingZeros());
+        }
+#if INTEGER_HPP_HAS_VECTOR
+        if (n <= p_straus_max) {
+            constexpr size_t w = 4;
+            std::vector<I> table(n * ((size_t(1) << w) - 1));
+            return ctx.from(p_straus(ctx, bases, exps, n, bits, w, table.data()));
+        }
+        // the bases are converted to Montgomery form once
+        std::vector<I> mont(n);
+        for (size_t i = 0; i < n; i++) {
+            mont[i] = ctx.to(bases[i]);
+        }
+        const size_t w = p_pippengerWindow(n, 8);
+        std::vector<I> buckets((size_t(1) << w) - 1);
+        return ctx.from(p_pippenger(ctx, mont.data(), exps, n, bits, true,
+                w, buckets.data()));
+#else
+        if (n <= p_straus_max) {
+            constexpr size_t w = p_tableWindow(size, p_straus_max, 4);
+            p_i_seq::v_array_t<I, p_straus_max * ((size_t(1) << w) - 1)> table{};
+            return ctx.from(p_straus(ctx, bases, exps, n, bits, w, &table[0]));
+        }
+        constexpr size_t max_w = p_tableWindow(size, 1, 8);
+        p_i_seq::v_array_t<I, (size_t(1) << max_w) - 1> buckets{};
+        return ctx.from(p_pippenger(ctx, bases, exps, n, bits, false,
+                p_pippengerWindow(n, max_w), &buckets[0]));
+#endif
+    }
+
+    // up to 256 values per chunk and at most 8 KB of prefix products on
+    // the stack, which stays small enough for the worker threads
+    constexpr inline size_t p_batchChunk(size_t size) noexcept {
+        return p_i_native::min<size_t>(256, p_i_native::max<size_t>(8192 / size, 8));
+    }
+
+    // Montgomery's trick on n <= p_batchChunk(size) values below an odd m.
+    // The raw values are multiplied in Montgomery form, the powers of R
+    // cancel out: with p the Montgomery product of all the values,
+    // 1 / p mod m times the prefix products gives the plain inverses.
+    // 3 * (n - 1) multiplications and a single inversion
+    template<size_t size>
+    constexpr bool p_batchModinv(const Montgomery<size> &ctx,
+            Integer<size, false> *values, size_t n) noexcept {
+        using I = Integer<size, false>;
+        p_i_seq::v_array_t<I, p_batchChunk(size)> prefix{};
+        I p = I(1U);
+        size_t k = 0;
+        // zeros are skipped, they stay zero
+        for (size_t i = 0; i < n; i++) {
+            if (!values[i].isZero()) {
+                p = k == 0 ? values[i] : ctx.mul(p, values[i]);
+                prefix[k++] = p;
+            }
+        }
+        if (k == 0) {
+            return n == 0;
+        }
+        const size_t nonzero = k;
+        I inv = modinv(p, ctx.modulus());
+        if (inv.isZero()) {
+            // a common factor with m, one by one
+            bool all = true;
+            for (size_t i = 0; i < n; i++) {
+                values[i] = modinv(values[i], ctx.modulus());
+                all = all && !values[i].isZero();
+            }
+            return all;
+        }
+        for (size_t i = n; i-- > 0;) {
+            if (!values[i].isZero()) {
+                const I v = values[i];
+                values[i] = --k == 0 ? inv : ctx.mul(inv, prefix[k - 1]);
+                inv = ctx.mul(inv, v);
+            }
+        }
+        return nonzero == n;
+    }
+
+    // values[i] = 1 / values[i] mod m in place, zero if there is no
+    // inverse. Returns whether all the values have one. Odd moduli use
+    // Montgomery's trick on chunks of p_batchChunk(size) values, even ones
+    // modinv
+    template<size_t size>
+    constexpr bool batch_modinv(Integer<size, false> *values, size_t n,
+            const Integer<size, false> &m) noexcept {
+        bool all = true;
+        if (!m.getBit(0)) {
+            for (size_t i = 0; i < n; i++) {
+                values[i] = modinv(values[i], m);
+                all = all && !values[i].isZero();
+            }
+            return all;
+        }
+        const Montgomery<size> ctx(m);
+        for (size_t i = 0; i < n; i++) {
+            if (values[i] >= m) {
+                values[i] %= m;
+            }
+        }
+        constexpr size_t chunk = p_batchChunk(size);
+        for (size_t i = 0; i < n; i += chunk) {
+            const size_t k = p_i_native::min(n - i, chunk);
+            all = p_batchModinv(ctx, values + i, k) && all;
+        }
+        return all;
+    }
+
+#if INTEGER_HPP_HAS_THREAD && INTEGER_HPP_HAS_VECTOR
+
+    // batch_modinv on contiguous slices in parallel, threads = 0 takes
+    // the hardware concurrency. Every thread gets at least min_slice values
+    template<size_t size>
+    bool batch_modinv_parallel(Integer<size, false> *values, size_t n,
+            const Integer<size, false> &m, size_t threads = 0,
+            size_t min_slice = 4096) {
+        if (threads == 0) {
+            threads = p_i_native::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+        threads = p_i_native::min(threads, p_i_native::max<size_t>(n / min_slice, 1));
+        if (threads <= 1) {
+            return batch_modinv(values, n, m);
+        }
+        const size_t slice = (n + threads - 1) / threads;
+        std::vector<char> all(threads, 1);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        try {
+            for (size_t t = 0; t < threads; t++) {
+                const size_t begin = t * slice;
+                const size_t k = begin < n ? p_i_native::min(slice, n - begin) : 0;
+                workers.emplace_back([&all, values, begin, k, &m, t]() {
+                    all[t] = batch_modinv(values + begin, k, m);
+                });
+            }
+        } catch (...) {
+            // the started threads still use values and all
+            for (std::thread &w : workers) {
+                w.join();
+            }
+            throw;
+        }
+        bool out = true;
+        for (size_t t = 0; t < threads; t++) {
+            workers[t].join();
+            out = out && all[t];
+        }
+        return out;
+    }
+#endif
+
+    // the primes below 256, trial division by them decides n < 65536
+    constexpr p_i_seq::v_array_t<unsigned, 54> p_small_primes = {
+        {
+            2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59,
+            61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+            137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197,
+            199, 211, 223, 227, 229, 233, 239, 241, 251
+        }
+    };
+
+    // 0 for a composite n, 1 for a prime one, 2 if it is not known. The
+    // primes are grouped in products that fit in a limb, so there is one
+    // short division per group and native remainders for the primes
+    template<size_t size>
+    constexpr int p_trialDivision(const Integer<size, false> &n) noexcept {
+        using L = p_i_limbs::L;
+        const size_t bits = size * 8 - n.numberOfLeadingZeros();
+        for (size_t i = 0; i < p_small_primes.length;) {
+            size_t end = i;
+            L prod = 1;
+            while (end < p_small_primes.length &&
+                    p_small_primes[end] <= L(~L(0)) / prod) {
+                prod *= p_small_primes[end++];
+            }
+            L r = 0;
+            divrem(n, prod, &r);
+            for (; i < end; i++) {
+                if (r % p_small_primes[i] == 0) {
+                    return bits <= 8 && n == p_small_primes[i] ? 1 : 0;
+                }
+            }
+        }
+        return bits <= 16 ? 1 : 2;
+    }
+
+    // Jacobi's symbol (a / n) for an odd n
+    constexpr inline int p_jacobi(p_i_limbs::L a, p_i_limbs::L n) noexcept {
+        int out = 1;
+        a %= n;
+        while (a != 0) {
+            while ((a & 1) == 0) {
+                a >>= 1;
+                if ((n & 7) == 3 || (n & 7) == 5) {
+                    out = -out;
+                }
+            }
+            const p_i_limbs::L t = a;
+            a = n;
+            n = t;
+            if ((a & 3) == 3 && (n & 3) == 3) {
+                out = -out;
+            }
+            a %= n;
+        }
+        return n == 1 ? out : 0;
+    }
+
+    // (d / n) for a small odd d and an odd n, by reciprocity
+    template<size_t size>
+    constexpr int p_jacobi(long d, const Integer<size, false> &n) noexcept {
+        using L = p_i_limbs::L;
+        const L a = L(d < 0 ? -d : d);
+        L r = 0;
+        divrem(n, a, &r);
+        int out = p_jacobi(r, a);
+        if ((a & 3) == 3 && n.getBit(1)) {
+            out = -out;
+        }
+        // (-1 / n)
+        return d < 0 && n.getBit(1) ? -out : out;
+    }
+
+    // Newton's steps from above, only for the rare n without a
+    // Selfridge parameter in the first tries
+    template<size_t size>
+    constexpr bool p_isSquare(const Integer<size, false> &n) noexcept {
+        using I = Integer<size, false>;
+        const size_t bits = size * 8 - n.numberOfLeadingZeros();
+        I x = I(1U) << ((bits + 1) / 2);
+        for (;;) {
+            I y = (x + n / x) >> 1;
+            if (y >= x) {
+                break;
+            }
+            x = y;
+        }
+        return x * x == n;
+    }
+
+    // strong probable prime test of an odd n to a base, n - 1 = d * 2^s
+    template<size_t size>
+    constexpr bool p_strongProbablePrime(const Montgomery<size> &ctx,
+            const Integer<size, false> &base, const Integer<size, false> &d,
+            size_t s) noexcept {
+        using I = Integer<size, false>;
+        const I &n = ctx.modulus();
+        const I b = base < n ? base : base % n;
+        if (b.isZero()) {
+            return true;
+        }
+        const I one = ctx.one();
+        const I minus = ctx.sub(I::ZERO(), one);
+        I x = ctx.pow(ctx.to(b), d);
+        if (x == one || x == minus) {
+            return true;
+        }
+        for (size_t i = 1; i < s; i++) {
+            x = ctx.sqr(x);
+            if (x == minus) {
+                return true;
+            }
+            if (x == one) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // x / 2 mod n for an odd n, in Montgomery form as well
+    template<size_t size>
+    constexpr Integer<size, false> p_half(const Integer<size, false> &x,
+            const Integer<size, false> &n) noexcept {
+        using I = Integer<size, false>;
+        if (!x.getBit(0)) {
+            return x >> 1;
+        }
+        I t = I::ZERO();
+        const bool carry = I::add_overflow(x, n, t);
+        t >>= 1;
+        t.setBit(size * 8 - 1, carry);
+        return t;
+    }
+
+    // a small v in Montgomery form
+    template<size_t size>
+    constexpr Integer<size, false> p_signedForm(const Montgomery<size> &ctx,
+            long v) noexcept {
+        using I = Integer<size, false>;
+        const I a = ctx.to(I(p_i_limbs::L(v < 0 ? -v : v)));
+        return v < 0 ? ctx.sub(I::ZERO(), a) : a;
+    }
+
+    // strong Lucas probable prime test with Selfridge's parameters,
+    // P = 1 and Q = (1 - D) / 4 for the first D in 5, -7, 9, -11, ...
+    // with (D / n) = -1. n is odd, not below 65536
+    template<size_t size>
+    constexpr bool p_strongLucas(const Montgomery<size> &ctx) noexcept {
+        using I = Integer<size, false>;
+        const I &n = ctx.modulus();
+        long d = 5;
+        for (size_t tries = 0;; tries++) {
+            const int j = p_jacobi(d, n);
+            if (j == -1) {
+                break;
+            }
+            // a factor |d| < n
+            if (j == 0) {
+                return false;
+            }
+            // no d exists for squares
+            if (tries == 16 && p_isSquare(n)) {
+                return false;
+            }
+            d = d > 0 ? -(d + 2) : 2 - d;
+        }
+        const long q = (1 - d) / 4;
+        const I md = p_signedForm(ctx, d);
+        const I mq = p_signedForm(ctx, q);
+        // n + 1 = k * 2^s, n + 1 itself may not fit
+        I k = (n >> 1) + 1U;
+        const size_t s = k.numberOfTrailingZeros() + 1;
+        k >>= s - 1;
+        // U_1 = 1, V_1 = P, then the doubling and the increment steps
+        I u = ctx.one(), v = ctx.one(), qk = mq;
+        for (size_t i = size * 8 - k.numberOfLeadingZeros() - 1; i-- > 0;) {
+            u = ctx.mul(u, v);
+            v = ctx.sub(ctx.sqr(v), ctx.add(qk, qk));
+            qk = ctx.sqr(qk);
+            if (k.getBit(i)) {
+                const I u1 = p_half(ctx.add(u, v), n);
+                v = p_half(ctx.add(ctx.mul(md, u), v), n);
+                u = u1;
+                qk = ctx.mul(qk, mq);
+            }
+        }
+        if (u.isZero() || v.isZero()) {
+            return true;
+        }
+        for (size_t i = 1; i < s; i++) {
+            v = ctx.sub(ctx.sqr(v), ctx.add(qk, qk));
+            if (v.isZero()) {
+                return true;
+            }
+            qk = ctx.sqr(qk);
+        }
+        return false;
+    }
+
+    // an odd n >= 65536 without small factors. Deterministic witnesses
+    // below 2^64 (Sinclair) and below 3.3 * 10^24 (the primes to 41,
+    // Sorenson and Webster), BPSW above
+    template<size_t size>
+    constexpr bool p_isPrime(const Montgomery<size> &ctx) noexcept {
+        using I = Integer<size, false>;
+        constexpr p_i_seq::v_array_t<p_i_limbs::L, 7> sinclair = {
+            {2, 325, 9375, 28178, 450775, 9780504, 1795265022}
+        };
+        const I &n = ctx.modulus();
+        const size_t bits = size * 8 - n.numberOfLeadingZeros();
+        const size_t s = (n - 1U).numberOfTrailingZeros();
+        const I d = (n - 1U) >> s;
+        if (bits <= 64) {
+            for (size_t i = 0; i < sinclair.length; i++) {
+                if (!p_strongProbablePrime(ctx, I(sinclair[i]), d, s)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (bits <= 81) {
+            for (size_t i = 0; p_small_primes[i] <= 41; i++) {
+                if (!p_strongProbablePrime(ctx, I(p_small_primes[i]), d, s)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return p_strongProbablePrime(ctx, I(2U), d, s) && p_strongLucas(ctx);
+    }
+
+    template<size_t size>
+    constexpr ct::if_t<bool, (size == p_i_native::max_native_size) >
+    p_isPrimeOdd(const Integer<size, false> &n) noexcept {
+        return p_isPrime(Montgomery<size>(n));
+    }
+
+    // narrower values are tested with narrower Montgomery arithmetic
+    template<size_t size>
+    constexpr ct::if_t<bool, (size > p_i_native::max_native_size) >
+    p_isPrimeOdd(const Integer<size, false> &n) noexcept {
+        using H = Integer<size / 2, false>;
+        if (n.numberOfLeadingZeros() >= size * 4) {
+            return p_isPrimeOdd(H(n));
+        }
+        return p_isPrime(Montgomery<size>(n));
+    }
+
+    template<size_t size>
+    constexpr ct::if_t<bool, (size < p_i_native::max_native_size) >
+    p_isPrimeOdd(const Integer<size, false> &n) noexcept {
+        return p_isPrimeOdd(Integer<p_i_native::max_native_size, false>(n));
+    }
+
+    // trial division by the primes below 256 with native remainders,
+    // then strong probable prime tests in Montgomery form. Deterministic
+    // below 3.3 * 10^24, BPSW above, with no known counterexample
+    template<size_t size>
+    constexpr bool is_prime(const Integer<size, false> &n) noexcept {
+        if (n < 2U) {
+            return false;
+        }
+        const int small = p_trialDivision(n);
+        return small == 2 ? p_isPrimeOdd(n) : small == 1;
+    }
+
+    // Reduction modulo a pseudo-Mersenne m = 2^k - c with a small c: as
+    // 2^k = c (mod m), the bits above k are folded back multiplied by c.
+    // The results of mul, sqr, add and sub are lazy, below 2^k but not
+    // always below m, and can be fed back without a final subtraction
+    template<size_t size>
+    class PseudoMersenne {
+        using I = Integer<size, false>;
+        using W = Integer<size * 2, false>;
+        using L = p_i_limbs::L;
+
+        I m;
+        size_t k;
+        L c;
+
+        constexpr static size_t bitLength(const W &v) noexcept {
+            return size * 16 - v.numberOfLeadingZeros();
+        }
+
+        constexpr I fold(p_i_limbs::array_t<size * 2> &t) const noexcept {
+            p_i_limbs::fold(t, k, c);
+            I out = I::ZERO();
+            p_loadLimbs(out, t, 0);
+            return out;
+        }
+    public:
+
+        // m = 2^k - c, c fits in a limb and has less than k / 2 bits,
+        // so that every fold removes about k bits
+        constexpr static bool accepts(const I &mod) noexcept {
+            const size_t k = size * 8 - mod.numberOfLeadingZeros();
+            const W c = (W(1U) << k) - W(mod);
+            return k > 2 && !c.isZero() && bitLength(c) <= p_i_limbs::limb_bits &&
+                    2 * bitLength(c) < k;
+        }
+
+        // mod must be accepted
+        constexpr explicit PseudoMersenne(const I &mod) noexcept : m(mod),
+        k(size * 8 - mod.numberOfLeadingZeros()),
+        c(p_i_limbs::L((W(1U) << k) - W(mod))) { }
+
+        constexpr const I& modulus() const noexcept {
+            return m;
+        }
+
+        // t mod 2^k + c * (t >> k) until t is below 2^k
+        constexpr I fold(const W &t) const noexcept {
+            p_i_limbs::array_t<size * 2> a{};
+            p_storeLimbs(t, a, 0);
+            return fold(a);
+        }
+
+        constexpr I mul(const I &a, const I &b) const noexcept {
+            p_i_limbs::array_t<size * 2> t{};
+            p_i_limbs::array_t<size> x{}, y{};
+            p_storeLimbs(a, x, 0);
+            p_storeLimbs(b, y, 0);
+            p_i_limbs::addmul_n(t, x, y);
+            return fold(t);
+        }
+
+        constexpr I sqr(const I &a) const noexcept {
+            return mul(a, a);
+        }
+
+        constexpr I add(const I &a, const I &b) const noexcept {
+            return fold(W(a) + b);
+        }
+
+        // 2^k <= 2m, so a + 2m - b is not negative for lazy values
+        constexpr I sub(const I &a, const I &b) const noexcept {
+            return fold(W(a) + W(m) * 2U - b);
+        }
+
+        // a lazy value to the one below m
+        constexpr I reduce(const I &a) const noexcept {
+            I out = fold(W(a));
+            return out >= m ? out - m : out;
+        }
+    };
+
+    enum p_ModType {
+        mod_mask,
+        mod_native,
+        mod_pseudo_mersenne,
+        mod_montgomery,
+        mod_barrett
+    };
+
+    template<size_t size>
+    constexpr inline p_ModType p_modType(const Integer<size, false> &m) noexcept {
+        return isOneBit(m) ? mod_mask :
+                size < p_i_native::max_native_size ? mod_native :
+                PseudoMersenne<size>::accepts(m) ? mod_pseudo_mersenne :
+                m.getBit(0) ? mod_montgomery : mod_barrett;
+    }
+
+    // reductions of ModInt, to() reduces any value to the inner form
+    template<size_t size, typename M, p_ModType =
+    p_modType(Integer<size, false>(M::value()))>
+    struct p_modint_h;
+
+    template<size_t size, typename M>
+    struct p_modint_h<size, M, mod_mask> {
+        using I = Integer<size, false>;
+        constexpr static I m = I(M::value());
+
+        constexpr inline static I to(const I &v) noexcept {
+            return v & (m - 1U);
+        }
+
+        constexpr inline static I from(const I &v) noexcept {
+            return v;
+        }
+
+        constexpr inline static I mul(const I &a, const I &b) noexcept {
+            return (a * b) & (m - 1U);
+        }
+    };
+
+    template<size_t size, typename M>
+    constexpr Integer<size, false> p_modint_h<size, M, mod_mask>::m;
+
+    // the double width product is native
+    template<size_t size, typename M>
+    struct p_modint_h<size, M, mod_native> {
+        using I = Integer<size, false>;
+        constexpr static I m = I(M::value());
+
+        constexpr inline static I to(const I &v) noexcept {
+            return v % m;
+        }
+
+        constexpr inline static I from(const I &v) noexcept {
+            return v;
+        }
+
+        constexpr inline static I mul(const I &a, const I &b) noexcept {
+            return I(wmultiply(a, b) % Integer<size * 2, false>(m));
+        }
+    };
+
+    template<size_t size, typename M>
+    constexpr Integer<size, false> p_modint_h<size, M, mod_native>::m;
+
+    template<size_t size, typename M>
+    struct p_modint_h<size, M, mod_pseudo_mersenne> {
+        using I = Integer<size, false>;
+        constexpr static I m = I(M::value());
+        constexpr static PseudoMersenne<size> ctx = PseudoMersenne<size>(m);
+
+        constexpr inline static I to(const I &v) noexcept {
+            return ctx.reduce(v);
+        }
+
+        constexpr inline static I from(const I &v) noexcept {
+            return v;
+        }
+
+        constexpr inline static I mul(const I &a, const I &b) noexcept {
+            // below 2^k, so below 2m
+            I out = ctx.mul(a, b);
+            return out >= m ? out - m : out;
+        }
+    };
+
+    template<size_t size, typename M>
+    constexpr Integer<size, false> p_modint_h<size, M, mod_pseudo_mersenne>::m;
+
+    template<size_t size, typename M>
+    constexpr PseudoMersenne<size> p_modint_h<size, M, mod_pseudo_mersenne>::ctx;
+
+    template<size_t size, typename M>
+    struct p_modint_h<size, M, mod_montgomery> {
+        using I = Integer<size, false>;
+        constexpr static I m = I(M::value());
+        constexpr static Montgomery<size> ctx = Montgomery<size>(m);
+
+        constexpr inline static I to(const I &v) noexcept {
+            return ctx.to(v);
+        }
+
+        constexpr inline static I from(const I &v) noexcept {
+            return ctx.from(v);
+        }
+
+        constexpr inline static I mul(const I &a, const I &b) noexcept {
+            return ctx.mul(a, b);
+        }
+    };
+
+    template<size_t size, typename M>
+    constexpr Integer<size, false> p_modint_h<size, M, mod_montgomery>::m;
+
+    template<size_t size, typename M>
+    constexpr Montgomery<size> p_modint_h<size, M, mod_montgomery>::ctx;
+
+    // Barrett reduction with mu = floor((2^(2 * bits) - 1) / m): the
+    // quotient estimate hi(t * mu) is at most 2 below t / m
+    template<size_t size, typename M>
+    struct p_modint_h<size, M, mod_barrett> {
+        using I = Integer<size, false>;
+        using W = Integer<size * 2, false>;
+        constexpr static I m = I(M::value());
+        constexpr static W mu = ~W::ZERO() / W(m);
+
+        constexpr inline static I reduce(const W &t) noexcept {
+            W r = t - mulhi(t, mu) * W(m);
+            while (r >= W(m)) {
+                r -= W(m);
+            }
+            return I(r);
+        }
+
+        constexpr inline static I to(const I &v) noexcept {
+            return reduce(W(v));
+        }
+
+        constexpr inline static I from(const I &v) noexcept {
+            return v;
+        }
+
+        constexpr inline static I mul(const I &a, const I &b) noexcept {
+            return reduce(wmultiply(a, b));
+        }
+    };
+
+    template<size_t size, typename M>
+    constexpr Integer<size, false> p_modint_h<size, M, mod_barrett>::m;
+
+    template<size_t size, typename M>
+    constexpr Integer<size * 2, false> p_modint_h<size, M, mod_barrett>::mu;
+
+    // modulus of a ModInt given by a native constant
+    template<typename T, T v>
+    struct NativeModulus {
+
+        constexpr static Integer<sizeof (T), false> value() noexcept {
+            return Integer<sizeof (T), false>(v);
+        }
+    };
+
+    // Integer modulo M::value(), M is a type with a constexpr static
+    // value(). The values are kept reduced, the reduction is chosen at
+    // compile time by the shape of the modulus: a mask for powers of two,
+    // native division below the limb size, folding for 2^k - c with a small
+    // c, Montgomery form for other odd moduli and Barrett reduction for
+    // the rest
+    template<size_t size, typename M>
+    class ModInt {
+        using I = Integer<size, false>;
+        using H = p_modint_h<size, M>;
+
+        static_assert(!I(M::value()).isZero(), "zero modulus");
+
+        // in the inner form of H
+        I data;
+
+        constexpr static ModInt raw(const I &v) noexcept {
+            ModInt out;
+            out.data = v;
+            return out;
+        }
+
+        template<typename T>
+        constexpr static I reduce(const T v) noexcept {
+            using S = Integer<sizeof (T), ct::is_signed<T>()>;
+            using U = Integer<sizeof (T), false>;
+            using R = Integer<(sizeof (T) > size ? sizeof (T) : size), false>;
+            const bool neg = S(v).isNegative();
+            I r = I(R(neg ? U(-S(v)) : U(v)) % R(H::m));
+            return neg && !r.isZero() ? H::m - r : r;
+        }
+    public:
+
+        constexpr static I modulus() noexcept {
+            return H::m;
+        }
+
+        constexpr ModInt() noexcept : data(I::ZERO()) { }
+
+        constexpr ModInt(const I &v) noexcept : data(H::to(v)) { }
+
+        template<typename T, ct::if_int_t<bool, T> = true >
+        constexpr ModInt(const T v) noexcept : data(H::to(reduce(v))) { }
+
+        constexpr static ModInt ONE() noexcept {
+            return ModInt(I(1U));
+        }
+
+        // the reduced value, below modulus()
+        constexpr I value() const noexcept {
+            return H::from(data);
+        }
+
+        constexpr bool isZero() const noexcept {
+            return data.isZero();
+        }
+
+        constexpr ModInt operator+(const ModInt &other) const noexcept {
+            I out = I::ZERO();
+            if (I::add_overflow(data, other.data, out) || out >= H::m) {
+                out -= H::m;
+            }
+            return raw(out);
+        }
+
+        constexpr ModInt operator-(const ModInt &other) const noexcept {
+            return raw(data < other.data ? data - other.data + H::m :
+                    data - other.data);
+        }
+
+        constexpr ModInt operator-() const noexcept {
+            return raw(data.isZero() ? data : H::m - data);
+        }
+
+        constexpr ModInt operator*(const ModInt &other) const noexcept {
+            return raw(H::mul(data, other.data));
+        }
+
+        constexpr ModInt& operator+=(const ModInt &other) noexcept {
+            return *this = *this + other;
+        }
+
+        constexpr ModInt& operator-=(const ModInt &other) noexcept {
+            return *this = *this - other;
+        }
+
+        constexpr ModInt& operator*=(const ModInt &other) noexcept {
+            return *this = *this * other;
+        }
+
+        constexpr bool operator==(const ModInt &other) const noexcept {
+            return data == other.data;
+        }
+
+        constexpr bool operator!=(const ModInt &other) const noexcept {
+            return data != other.data;
+        }
+
+        // left to right binary powering
+        template<size_t size2>
+        constexpr ModInt pow(const Integer<size2, false> &e) const noexcept {
+            ModInt out = ONE();
+            for (size_t i = size2 * 8 - e.numberOfLeadingZeros(); i-- > 0;) {
+                out *= out;
+                if (e.getBit(i)) {
+                    out *= *this;
+                }
+            }
+            return out;
+        }
+
+        // negative exponents are powers of the inverse
+        template<typename T, ct::if_int_t<bool, T> = true >
+        constexpr ModInt pow(const T e) const noexcept {
+            using S = Integer<sizeof (T), ct::is_signed<T>()>;
+            using U = Integer<sizeof (T), false>;
+            return S(e).isNegative() ? inverse().pow(U(-S(e))) : pow(U(e));
+        }
+
+        // zero if there is no inverse
+        constexpr ModInt inverse() const noexcept {
+            return ModInt(modinv(value(), H::m));
+        }
+    };
+
+#if INTEGER_HPP_HAS_CMATH
+
+    namespace p_i_float {
+
+        using L = p_i_limbs::L;
+
+        // limb_bits bits of a starting at bit pos, zeros past the end
+        template<size_t n>
+        constexpr inline L extract(const p_i_seq::v_array_t<L, n> &a,
+                size_t pos) noexcept {
+            const size_t k = pos / p_i_limbs::limb_bits;
+            L low = k < n ? a[k] : 0;
+            L high = k + 1 < n ? a[k + 1] : 0;
+            return p_i_limbs::shrd(high, low, pos & p_i_limbs::limb_mask);
+        }
+
+        // true if any bit of a below pos is set
+        template<size_t n>
+        constexpr inline bool sticky(const p_i_seq::v_array_t<L, n> &a,
+                size_t pos) noexcept {
+            const size_t k = pos / p_i_limbs::limb_bits;
+            for (size_t i = 0; i < k && i < n; i++) {
+                if (a[i]) {
+                    return true;
+                }
+            }
+            return k < n && (a[k] & ((L(1) << (pos & p_i_limbs::limb_mask)) - 1));
+        }
+
+        // a * 2^scale rounded to the nearest F, ties to even
+        template<typename F, size_t n>
+        inline F round(const p_i_seq::v_array_t<L, n> &a, long scale) noexcept {
+            using limits = std::numeric_limits<F>;
+            static_assert(limits::radix == 2 && limits::digits <= 2 *
+                    long(p_i_limbs::limb_bits), "unsupported floating type");
+            constexpr long digits = limits::digits;
+            // exponent of the lowest subnormal bit
+            constexpr long lowest = long(limits::min_exponent) - digits;
+            const size_t len = p_i_limbs::length(a);
+            if (len == 0) {
+                return F(0);
+            }
+            const long top = long(len * p_i_limbs::limb_bits) - 1 -
+                    p_i_utils::numberOfLeadingZeros_n(a[len - 1]);
+            // lowest kept bit of a
+            long shift = p_i_native::max(top + scale - digits + 1, lowest) - scale;
+            L m0 = 0, m1 = 0;
+            if (shift <= 0) {
+                // exact
+                shift = 0;
+                m0 = extract(a, 0);
+                m1 = extract(a, p_i_limbs::limb_bits);
+            } else {
+                m0 = extract(a, size_t(shift));
+                m1 = extract(a, size_t(shift) + p_i_limbs::limb_bits);
+                bool half = extract(a, size_t(shift) - 1) & 1;
+                if (half && ((m0 & 1) || sticky(a, size_t(shift) - 1))) {
+                    m0++;
+                    m1 += m0 == 0;
+                }
+            }
+            // both parts and their sum are exact
+            F out = F(m0);
+            if (m1) {
+                out += std::ldexp(F(m1), int(p_i_limbs::limb_bits));
+            }
+            return std::ldexp(out, int(shift + scale));
+        }
+
+        // the conversion of native values is exact or correctly rounded
+        template<typename F, size_t size>
+        inline ct::if_t<F, p_intType(size) == native>
+        load(const Integer<size, false> &v) noexcept {
+            return F(v.uvalue());
+        }
+
+        template<typename F, size_t size>
+        inline ct::if_t<F, p_intType(size) == pow2>
+        load(const Integer<size, false> &v) noexcept {
+            p_i_limbs::array_t<size> a{};
+            p_storeLimbs(v, a, 0);
+            return round<F>(a, 0);
+        }
+    }
+
+    template<typename F, size_t size, bool sig>
+    inline F p_toFloat(const Integer<size, sig> &v) noexcept {
+        using UI = Integer<size, false>;
+        const bool neg = v.isNegative();
+        F out = p_i_float::load<F>(neg ? UI(-v) : UI(v));
+        return neg ? -out : out;
+    }
+
+    template<size_t size, bool sig, typename F>
+    inline Integer<size, sig> p_fromFloat(const F x) noexcept {
+        using UI = Integer<size, false>;
+        using W = Integer<p_i_native::max_native_size * 2, false>;
+        using L = p_i_limbs::L;
+        constexpr int digits = std::numeric_limits<F>::digits;
+        static_assert(std::numeric_limits<F>::radix == 2 &&
+                digits <= 2 * int(p_i_limbs::limb_bits), "unsupported floating type");
+        if (!std::isfinite(x) || std::fabs(x) < 1) {
+            return Integer<size, sig>::ZERO();
+        }
+        int e = 0;
+        F f = std::frexp(std::fabs(x), &e);
+        // |x| = m * 2^(e - digits), m is an integer of two limbs
+        F m = std::ldexp(f, digits);
+        F high = std::floor(std::ldexp(m, -int(p_i_limbs::limb_bits)));
+        W w(L(m - std::ldexp(high, int(p_i_limbs::limb_bits))), L(high));
+        const int shift = e - digits;
+        UI out = UI::ZERO();
+        if (shift < 0) {
+            out = UI(w >> size_t(-shift));
+        } else if (size_t(shift) < size * 8) {
+            out = UI(w);
+            out <<= size_t(shift);
+        }
+        return Integer<size, sig>(x < 0 ? -out : out);
+    }
+
+    // Exact sum of doubles (Kulisch accumulator). Every finite double is
+    // an integer multiple of 2^-1074 below 2^1024, so it is added to
+    // a fixed point number of size bytes at its place and the result
+    // is rounded once. Positive and negative terms are kept apart, so
+    // carries only run upwards and mostly stop in the next limb. The sum
+    // does not depend on the order of the terms
+    template<size_t size = 512 >
+    class ExactSum {
+        using L = p_i_limbs::L;
+        using limits = std::numeric_limits<double>;
+        using array = p_i_limbs::array_t<size>;
+        constexpr static size_t n = p_i_limbs::count<size>();
+    public:
+        // exponent of the lowest bit of the accumulator
+        constexpr static long scale = long(limits::min_exponent) - limits::digits;
+    private:
+        constexpr static size_t range = size_t(limits::max_exponent - scale);
+
+        static_assert(limits::is_iec559 && limits::digits <= long(p_i_limbs::limb_bits),
+                "unsupported double format");
+        static_assert(size * 8 >= range + p_i_limbs::limb_bits,
+                "too small accumulator");
+
+        array pos{}, negs{};
+        bool nan = false, pinf = false, ninf = false;
+
+        // a += x * 2^shift
+        static void accumulate(array &a, L x, size_t shift) noexcept {
+            const size_t k = shift / p_i_limbs::limb_bits;
+            const size_t s = shift & p_i_limbs::limb_mask;
+            // x has less than limb_bits bits, so high + carry does not overflow
+            L low = x << s;
+            L high = p_i_limbs::shld(0, x, s);
+            a[k] += low;
+            high += a[k] < low;
+            a[k + 1] += high;
+            bool carry = a[k + 1] < high;
+            for (size_t i = k + 2; carry && i < n; i++) {
+                carry = ++a[i] == 0;
+            }
+        }
+    public:
+
+        ExactSum() = default;
+
+        ExactSum& add(double x) noexcept {
+            if (std::isnan(x)) {
+                nan = true;
+            } else if (std::isinf(x)) {
+                (x < 0 ? ninf : pinf) = true;
+            } else if (x != 0) {
+                int e = 0;
+                double f = std::frexp(std::fabs(x), &e);
+                // x = m * 2^(e - digits), m is an integer
+                L m = L(std::ldexp(f, limits::digits));
+                long shift = e - limits::digits - scale;
+                if (shift < 0) {
+                    // subnormal, the dropped bits are zeros
+                    m >>= -shift;
+                    shift = 0;
+                }
+                accumulate(x < 0 ? negs : pos, m, size_t(shift));
+            }
+            return *this;
+        }
+
+        ExactSum& operator+=(double x) noexcept {
+            return add(x);
+        }
+
+        // adds the terms of other, for parallel reductions
+        ExactSum& merge(const ExactSum &other) noexcept {
+            p_i_limbs::add_n(pos, other.pos);
+            p_i_limbs::add_n(negs, other.negs);
+            nan |= other.nan;
+            pinf |= other.pinf;
+            ninf |= other.ninf;
+            return *this;
+        }
+
+        ExactSum& operator+=(const ExactSum &other) noexcept {
+            return merge(other);
+        }
+
+        bool isFinite() const noexcept {
+            return !(nan || pinf || ninf);
+        }
+
+        // exact sum of the finite terms times 2^-scale
+        Integer<size, true> value() const noexcept {
+            array tmp = pos;
+            p_i_limbs::sub_n(tmp, negs);
+            Integer<size, true> out = Integer<size, true>::ZERO();
+            p_loadLimbs(out, tmp, 0);
+            return out;
+        }
+
+        // correctly rounded sum, ties to even
+        double result() const noexcept {
+            if (nan || (pinf && ninf)) {
+                return limits::quiet_NaN();
+            }
+            if (pinf || ninf) {
+                return pinf ? limits::infinity() : -limits::infinity();
+            }
+            array tmp = pos;
+            p_i_limbs::sub_n(tmp, negs);
+            bool neg = tmp[n - 1] >> p_i_limbs::limb_mask;
+            if (neg) {
+                array mag{};
+                p_i_limbs::sub_n(mag, tmp);
+                tmp = mag;
+            }
+            double out = p_i_float::round<double>(tmp, scale);
+            return neg ? -out : out;
+        }
+    };
+
+    // r^k, k is a constant
+    template<size_t k, typename I>
+    constexpr inline I p_ipow(const I &r) noexcept {
+        I out = (k & 1) ? r : I(1U);
+        I base = r;
+        for (size_t e = k >> 1; e != 0; e >>= 1) {
+            base *= base;
+            if (e & 1) {
+                out *= base;
+            }
+        }
+        return out;
+    }
+
+    // v * 2^e as an integer, the double keeps its precision
+    // when the exponent is out of its range
+    template<typename I>
+    inline I p_scaled(double v, long e) noexcept {
+        const long d = p_i_native::min(e, long(60 - std::ilogb(v)));
+        return I(std::ldexp(v, int(d))) << size_t(e - d);
+    }
+
+    template<size_t k>
+    inline double p_rootSeed(double t) noexcept {
+        return k == 2 ? std::sqrt(t) : std::pow(t, 1.0 / double(k));
+    }
+
+    // the double of a native value is close enough to be fixed by a step
+    template<size_t k, size_t size>
+    inline ct::if_t<Integer<size, false>, p_intType(size) == native>
+    p_irootSeed(const Integer<size, false> &x, size_t) noexcept {
+        return Integer<size, false>(p_rootSeed<k>(double(x)));
+    }
+
+    // x = t * 2^sh, the root of the double of t is refined by Newton's
+    // steps for the root and for h = 2^F / (k * r^(k - 1)) together, so
+    // the step for the root is a multiplication by h instead of a division
+    template<size_t k, size_t size>
+    inline ct::if_t<Integer<size, false>, p_intType(size) == pow2>
+    p_irootSeed(const Integer<size, false> &x, size_t n) noexcept {
+        using SW = Integer<size * 2, true>;
+        // sh is a multiple of k, t has up to 64 bits
+        const long sh = n > 64 ? long((n - 64 + k - 1) / k * k) : 0;
+        const double t = double(p_i_limbs::L(x >> size_t(sh)));
+        const double root = p_rootSeed<k>(t);
+        const size_t F = n + 8;
+        SW r = p_scaled<SW>(root, sh / long(k));
+        SW h = p_scaled<SW>(1.0 / (double(k) * std::pow(root, double(k - 1))),
+                long(F) - sh / long(k) * long(k - 1));
+        // bits of the seed, doubled by every step
+        for (size_t p = 48;; p *= 2) {
+            r += ((SW(x) - p_ipow<k>(r)) * h) >> F;
+            if (p >= n / k + 2) {
+                break;
+            }
+            h += (h * ((SW(1U) << F) - p_ipow<k - 1>(r) * SW(k) * h)) >> F;
+        }
+        return Integer<size, false>(r);
+    }
+
+    template<size_t k, size_t size>
+    inline Integer<size, false>
+    p_iroot(const Integer<size, false> &x, Integer<size, false> *rem) noexcept {
+        static_assert(k >= 2, "k must be at least 2");
+        using UI = Integer<size, false>;
+        using W = Integer<size * 2, false>;
+        const size_t n = size * 8 - x.numberOfLeadingZeros();
+        UI out = x.isZero() ? UI::ZERO() : UI(1U);
+        // x < 2^k has 1 as the root, so r^k fits in W below
+        if (n > k) {
+            out = p_irootSeed<k>(x, n);
+            // the seed is off by a few units at most
+            while (p_ipow<k>(W(out)) > W(x)) {
+                --out;
+            }
+            while (p_ipow<k>(W(out) + 1U) <= W(x)) {
+                ++out;
+            }
+        }
+        if (rem) {
+            *rem = UI(W(x) - p_ipow<k>(W(out)));
+        }
+        return out;
+    }
+
+    // floor(sqrt(x))
+    template<size_t size>
+    inline Integer<size, false> isqrt(const Integer<size, false> &x) noexcept {
+        return p_iroot<2>(x, (Integer<size, false>*)nullptr);
+    }
+
+    // floor(sqrt(x)), rem is set to x - root^2
+    template<size_t size>
+    inline Integer<size, false> isqrt_rem(const Integer<size, false> &x,
+            Integer<size, false> *rem) noexcept {
+        return p_iroot<2>(x, rem);
+    }
+
+    // floor(x^(1/k)), k >= 2
+    template<size_t k, size_t size>
+    inline Integer<size, false> iroot(const Integer<size, false> &x) noexcept {
+        return p_iroot<k>(x, (Integer<size, false>*)nullptr);
+    }
+#endif
+
+#if INTEGER_HPP_HAS_VECTOR
+
+    // Static bit vector made of Integer<size, false> blocks with
+    // a two level rank directory: absolute counts per super block and
+    // 16 bit counts relative to the super block per block. rank is O(1).
+    // select starts from the block of every select_sample-th set bit, it
+    // is a binary search over the blocks between two samples: O(1) for a
+    // bounded density, O(log n) for the sparsest vectors
+    template<size_t size = 64 >
+    class SuccinctBitVector {
+    public:
+        using block_t = Integer<size, false>;
+        constexpr static size_t block_bits = size * p_i_native::min_native_bits;
+    private:
+        using rel_t = p_i_native::native_int_type<2, false>;
+        constexpr static size_t super_blocks = p_i_native::max<size_t>(
+                (size_t(1) << 16) / block_bits, 1);
+
+        constexpr static size_t select_sample = size_t(1) << 12;
+
+        static_assert(block_bits * (super_blocks - 1) <= rel_t(~rel_t(0)),
+                "too big block");
+
+        std::vector<block_t> data;
+        std::vector<size_t> super;
+        std::vector<rel_t> rel;
+        // the block of the (i * select_sample)-th set bit, then the last one
+        std::vector<size_t> hints;
+
+        void build() {
+            size_t n = data.size();
+            super.resize((n + super_blocks - 1) / super_blocks + 1);
+            rel.resize(n);
+            hints.clear();
+            size_t total = 0, base = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (i % super_blocks == 0) {
+                    super[i / super_blocks] = base = total;
+                }
+                rel[i] = rel_t(total - base);
+                total += data[i].bitCount();
+                while (hints.size() * select_sample < total) {
+                    hints.push_back(i);
+                }
+            }
+            super.back() = total;
+            if (n != 0) {
+                hints.push_back(n - 1);
+            }
+        }
+
+        // set bits in the blocks below b
+        size_t before(size_t b) const noexcept {
+            return super[b / super_blocks] + rel[b];
+        }
+    public:
+
+        SuccinctBitVector() : super(1, 0) { }
+
+        explicit SuccinctBitVector(std::vector<block_t> blocks) :
+        data(std::move(blocks)) {
+            build();
+        }
+
+        SuccinctBitVector(const block_t *blocks, size_t count) :
+        data(blocks, blocks + count) {
+            build();
+        }
+
+        // length in bits
+        size_t length() const noexcept {
+            return data.size() * block_bits;
+        }
+
+        size_t bitCount() const noexcept {
+            return super.back();
+        }
+
+        const std::vector<block_t>& blocks() const noexcept {
+            return data;
+        }
+
+        bool getBit(size_t index) const noexcept {
+            return data[index / block_bits].getBit(index % block_bits);
+        }
+
+        // number of set bits below index, 0 <= index <= length()
+        size_t rank(size_t index) const noexcept {
+            size_t b = index / block_bits;
+            if (b == data.size()) {
+                return bitCount();
+            }
+            return before(b) + data[b].rank(index % block_bits);
+        }
+
+        // position of the k-th (from 0) set bit or length()
+        size_t select(size_t k) const noexcept {
+            if (k >= bitCount()) {
+                return length();
+            }
+            // last block with count <= k, between the blocks of the
+            // samples around k
+            size_t first = hints[k / select_sample];
+            size_t last = hints[k / select_sample + 1] + 1;
+            while (last - first > 1) {
+                size_t mid = (first + last) / 2;
+                if (before(mid) <= k) {
+                    first = mid;
+                } else {
+                    last = mid;
+                }
+            }
+            return first * block_bits + data[first].select(k - before(first));
+        }
+    };
+#endif
+
+    namespace p_i_morton {
+
+        // bit i of a component at stage s (all stages >= s are done)
+        constexpr inline size_t position(size_t i, size_t s, size_t D) noexcept {
+            return i + (i & ~(s - 1)) * (D - 1);
+        }
+
+        template<typename R, size_t D, size_t bits>
+        constexpr inline R stageMask(size_t s) noexcept {
+            R out = R::ZERO();
+            for (size_t i = 0; i < bits; i++) {
+                out.setBit(position(i, s, D), true);
+            }
+            return out;
+        }
+
+        template<size_t D, size_t bits, size_t s, typename R>
+        constexpr inline ct::if_t<R, s == 0 > spread(const R &x) noexcept {
+            return x;
+        }
+
+        // HD, Section 7-2, generalized to D components
+        template<size_t D, size_t bits, size_t s, typename R>
+        constexpr inline ct::if_t<R, s != 0 > spread(const R &x) noexcept {
+            constexpr R mask = stageMask<R, D, bits>(s);
+            return spread<D, bits, s / 2 > ((x | (x << (s * (D - 1)))) & mask);
+        }
+
+        template<size_t D, size_t bits, size_t s, typename R>
+        constexpr inline ct::if_t<R, (s >= bits) > compact(const R &x) noexcept {
+            return x;
+        }
+
+        template<size_t D, size_t bits, size_t s, typename R>
+        constexpr inline ct::if_t<R, (s < bits) > compact(const R &x) noexcept {
+            constexpr R mask = stageMask<R, D, bits>(s * 2);
+            return compact<D, bits, s * 2 > ((x | (x >> (s * (D - 1)))) & mask);
+        }
+
+        template<size_t D, size_t bits, typename R>
+        constexpr inline R encode(const R &x, size_t j) noexcept {
+#if INTEGER_HPP_HAS_BMI2
+            if (!__builtin_is_constant_evaluated()) {
+                // bits j, j + D, j + 2 * D, ...
+                constexpr R lanes = stageMask<R, D, bits>(1);
+                return x.expand(lanes << j);
+            }
+#endif
+            constexpr size_t top = size_t(1) << p_i_utils::lpo2_s(bits - 1);
+            return spread<D, bits, (bits > 1 ? top : 0) > (x) << j;
+        }
+
+        template<size_t D, size_t bits, typename R>
+        constexpr inline R decode(const R &key, size_t j) noexcept {
+            constexpr R lanes = stageMask<R, D, bits>(1);
+#if INTEGER_HPP_HAS_BMI2
+            if (!__builtin_is_constant_evaluated()) {
+                return key.compress(lanes << j);
+            }
+#endif
+            return compact<D, bits, 1 > ((key >> j) & lanes);
+        }
+
+        template<size_t D, typename T>
+        using key_t = Integer<p_i_utils::make_pow2(D * sizeof (T)), false>;
+    }
+
+    // Morton (Z-order) key, bit i of the j-th component goes to bit i * D + j
+    template<size_t D, typename T, typename... Tp,
+    typename R = p_i_morton::key_t<D, T>>
+    constexpr inline ct::if_int_t<R, T, (D == sizeof...(Tp) + 1) && (D > 0) >
+    mortonEncode(const T first, const Tp... rest) noexcept {
+        constexpr size_t bits = sizeof (T) * p_i_native::min_native_bits;
+        using UT = typename std::make_unsigned<T>::type;
+        p_i_seq::v_array_t<UT, D> c = {{UT(first), UT(rest)...}};
+        R out = R::ZERO();
+        for (size_t j = 0; j < D; j++) {
+            out |= p_i_morton::encode<D, bits>(R(c[j]), j);
+        }
+        return out;
+    }
+
+    template<size_t D, typename T, typename R = p_i_morton::key_t<D, T>>
+    constexpr inline ct::if_int_t<void, T, (D > 0) >
+    mortonDecode(const R &key, p_i_utils::array_ref<T, D> out) noexcept {
+        constexpr size_t bits = sizeof (T) * p_i_native::min_native_bits;
+        for (size_t j = 0; j < D; j++) {
+            out[j] = T(p_i_morton::decode<D, bits>(key, j));
+        }
+    }
+
+    // batch versions, points are stored as count * D components
+    template<size_t D, typename T, typename R = p_i_morton::key_t<D, T>>
+    inline ct::if_int_t<void, T, (D > 0) >
+    mortonEncode(const T *points, size_t count, R *keys) noexcept {
+        constexpr size_t bits = sizeof (T) * p_i_native::min_native_bits;
+        using UT = typename std::make_unsigned<T>::type;
+        for (size_t i = 0; i < count; i++, points += D) {
+            R out = R::ZERO();
+            for (size_t j = 0; j < D; j++) {
+                out |= p_i_morton::encode<D, bits>(R(UT(points[j])), j);
+            }
+            keys[i] = out;
+        }
+    }
+
+    template<size_t D, typename T, typename R = p_i_morton::key_t<D, T>>
+    inline ct::if_int_t<void, T, (D > 0) >
+    mortonDecode(const R *keys, size_t count, T *points) noexcept {
+        constexpr size_t bits = sizeof (T) * p_i_native::min_native_bits;
+        for (size_t i = 0; i < count; i++, points += D) {
+            for (size_t j = 0; j < D; j++) {
+                points[j] = T(p_i_morton::decode<D, bits>(keys[i], j));
+            }
+        }
+    }
+
     namespace p_literal {
         template <typename T, T... values>
         using array_t = p_i_seq::array_t<T, values...>;
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#define INTEGER_HPP_HAS_THREAD 1
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+
+using namespace JIO;
+
+template<size_t size>
+static void checkBatch(const U<size> &m, size_t n, bool zeros, uint64_t &state) {
+    std::vector<U<size>> values, expected;
+    bool all = true;
+    for (size_t i = 0; i < n; i++) {
+        U<size> v = zeros && next(state) % 16 == 0 ? U<size>::ZERO() : randomValue<U<size>>(state);
+        values.push_back(v);
+        expected.push_back(modinv(v, m));
+        all = all && !expected.back().isZero();
+    }
+    ASSERT_EQ(batch_modinv(values.data(), n, m), all);
+    ASSERT_EQ(values, expected);
+}
+
+TEST(BatchInverse, prime) {
+    uint64_t state = 0x5be0cd19137e2179ULL;
+    const U<32> p = (U<32>(1U) << 255) - 19U;
+    for (size_t n : {0, 1, 2, 17, 256, 257, 1000}) {
+        checkBatch(p, n, false, state);
+        checkBatch(p, n, true, state);
+    }
+    checkBatch(U<8>(998244353U), 600, true, state);
+    checkBatch(U<16>((U<16>(1U) << 127) - 1U), 300, false, state);
+    // chunks of 32 values at 256 bytes
+    checkBatch((U<256>(1U) << 2047) - 1U, 100, true, state);
+}
+
+TEST(BatchInverse, composite) {
+    uint64_t state = 0xcbbb9d5dc1059ed8ULL;
+    // odd moduli with non invertible values, and even moduli
+    checkBatch(U<8>(3U * 5U * 7U * 11U * 13U), 300, false, state);
+    checkBatch(randomValue<U<32>>(state) | 1U, 300, true, state);
+    checkBatch(U<8>(1U) << 40, 100, false, state);
+    checkBatch(randomValue<U<16>>(state) & ~U<16>(1U), 100, true, state);
+}
+
+TEST(BatchInverse, parallel) {
+    uint64_t state = 0x629a292a367cd507ULL;
+    const U<16> p = (U<16>(1U) << 127) - 1U;
+    std::vector<U<16>> values;
+    for (size_t i = 0; i < 20000; i++) {
+        values.push_back(randomValue<U<16>>(state));
+    }
+    std::vector<U<16>> serial = values;
+    ASSERT_TRUE(batch_modinv(serial.data(), serial.size(), p));
+    ASSERT_TRUE(batch_modinv_parallel(values.data(), values.size(), p, 4, 1000));
+    ASSERT_EQ(values, serial);
+    values[123] = U<16>::ZERO();
+    ASSERT_FALSE(batch_modinv_parallel(values.data(), values.size(), p, 3, 1000));
+    ASSERT_TRUE(values[123].isZero());
+}
+
+static constexpr U<8> inverseSum() {
+    U<8> v[] = {U<8>(2U), U<8>(3U), U<8>::ZERO(), U<8>(4U)};
+    batch_modinv(v, 4, U<8>(1000000007U));
+    return v[0] + v[1] + v[2] + v[3];
+}
+
+TEST(BatchInverse, constexpr_batch) {
+    static_assert(inverseSum() == U<8>(500000004U) + U<8>(333333336U) + U<8>(250000002U), "");
+}
@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+#include <vector>
+
+using namespace JIO;
+
+template<typename I>
+static std::vector<size_t> setBits(const I &v) {
+    std::vector<size_t> out;
+    v.forEachSetBit([&out](size_t i) {
+        out.push_back(i);
+    });
+    return out;
+}
+
+TEST(Bits, runtime_bit_native) {
+    U<4> v = U<4>::ZERO();
+    v.setBit(0, true).setBit(31, true).flipBit(7);
+    EXPECT_EQ(v, U<4>(0x80000081U));
+    EXPECT_TRUE(v.getBit(31));
+    EXPECT_FALSE(v.getBit(30));
+    v.setBit(31, false);
+    EXPECT_EQ(v, U<4>(0x81U));
+    EXPECT_EQ(v.getByte(0), 0x81);
+    v.setByte(3, 0xab);
+    EXPECT_EQ(v, U<4>(0xab000081U));
+    EXPECT_EQ(v.getByte(3), 0xab);
+    EXPECT_EQ(setBits(v), (std::vector<size_t>{0, 7, 24, 25, 27, 29, 31}));
+}
+
+TEST(Bits, runtime_bit_pow2) {
+    constexpr size_t bits = 1024;
+    U<128> v = U<128>::ZERO();
+    std::vector<bool> ref(bits);
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < 2000; i++) {
+        size_t index = next(state) % bits;
+        switch (next(state) % 3) {
+            case 0:
+                v.setBit(index, true);
+                ref[index] = true;
+                break;
+            case 1:
+                v.setBit(index, false);
+                ref[index] = false;
+                break;
+            default:
+                v.flipBit(index);
+                ref[index] = !ref[index];
+        }
+    }
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < bits; i++) {
+        ASSERT_EQ(v.getBit(i), ref[i]) << i;
+        if (ref[i]) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(setBits(v), expected);
+    for (size_t i = 0; i < 128; i++) {
+        unsigned char b = 0;
+        for (size_t j = 0; j < 8; j++) {
+            b |= ref[i * 8 + j] << j;
+        }
+        ASSERT_EQ(v.getByte(i), b) << i;
+    }
+}
+
+TEST(Bits, runtime_matches_template) {
+    U<16> v = U<16>(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    EXPECT_EQ(v.getByte(0), v.getByte<0>());
+    EXPECT_EQ(v.getByte(9), v.getByte<9>());
+    EXPECT_EQ(v.getByte(15), v.getByte<15>());
+    EXPECT_EQ(v.getBit(0), v.getBit<0>());
+    EXPECT_EQ(v.getBit(68), v.getBit<68>());
+    EXPECT_EQ(v.getBit(127), v.getBit<127>());
+    v.setByte(8, 0x00);
+    EXPECT_EQ(v.uhigh(), 0xfedcba9876543200ULL);
+}
+
+TEST(Bits, for_each_set_bit_offset) {
+    S<16> v = -S<16>(1) << 126;
+    EXPECT_EQ(setBits(v), (std::vector<size_t>{126, 127}));
+    std::vector<size_t> out;
+    v.forEachSetBit([&out](size_t i) {
+        out.push_back(i);
+    }, 1000);
+    EXPECT_EQ(out, (std::vector<size_t>{1126, 1127}));
+}
+
+TEST(Bits, constexpr_runtime_bit) {
+    constexpr U<32> v = U<32>::ZERO().addOne() << 200;
+    static_assert(v.getBit(200) && !v.getBit(199), "constexpr getBit");
+    static_assert(v.getByte(25) == 1, "constexpr getByte");
+    EXPECT_TRUE(v.getBit(200));
+}
+
+template<typename I>
+static I randomBits(uint64_t &state, unsigned density) {
+    I v = I::ZERO();
+    for (size_t i = 0; i < sizeof (I) * 8; i++) {
+        if (next(state) % 8 < density) {
+            v.setBit(i, true);
+        }
+    }
+    return v;
+}
+
+template<typename I>
+static void checkRankSelect(uint64_t seed) {
+    constexpr size_t bits = sizeof (I) * 8;
+    for (unsigned density = 0; density <= 8; density += 2) {
+        I v = randomBits<I>(seed, density);
+        size_t count = 0;
+        for (size_t i = 0; i < bits; i++) {
+            ASSERT_EQ(v.rank(i), count) << i;
+            if (v.getBit(i)) {
+                ASSERT_EQ(v.select(count), i) << count;
+                count++;
+            }
+        }
+        ASSERT_EQ(v.rank(bits), count);
+        ASSERT_EQ(v.bitCount(), count);
+        ASSERT_EQ(v.select(count), bits);
+    }
+}
+
+TEST(Bits, rank_select) {
+    checkRankSelect<U<1>>(1);
+    // native signed values shift their sign bit
+    checkRankSelect<S<1>>(6);
+    checkRankSelect<S<4>>(7);
+    checkRankSelect<S<8>>(8);
+    checkRankSelect<U<8>>(2);
+    checkRankSelect<U<16>>(3);
+    checkRankSelect<U<64>>(4);
+    checkRankSelect<S<128>>(5);
+}
+
+TEST(Bits, constexpr_rank_select) {
+    constexpr U<16> v = U<16>(0x8000000000000001ULL, 0x10ULL);
+    static_assert(v.bitCount() == 3, "constexpr bitCount");
+    static_assert(v.rank(64) == 2 && v.rank(65) == 2, "constexpr rank");
+    static_assert(v.select(0) == 0 && v.select(1) == 63 &&
+            v.select(2) == 68 && v.select(3) == 128, "constexpr select");
+    EXPECT_EQ(v.select(2), 68U);
+}
+
+TEST(Bits, succinct_bit_vector) {
+    uint64_t state = 0x0f1e2d3c4b5a6978ULL;
+    std::vector<U<64>> blocks;
+    // sparse, dense and empty regions, more than one super block
+    for (int i = 0; i < 300; i++) {
+        blocks.push_back(randomBits<U<64>>(state, (i / 50) % 3 == 2 ? 0 : 1 + i % 7));
+    }
+    SuccinctBitVector<64> bv(blocks);
+    ASSERT_EQ(bv.length(), 300U * 512);
+    size_t count = 0;
+    for (size_t i = 0; i < bv.length(); i++) {
+        ASSERT_EQ(bv.rank(i), count) << i;
+        if (bv.getBit(i)) {
+            ASSERT_EQ(bv.select(count), i) << count;
+            count++;
+        }
+    }
+    EXPECT_EQ(bv.rank(bv.length()), count);
+    EXPECT_EQ(bv.bitCount(), count);
+    EXPECT_EQ(bv.select(count), bv.length());
+
+    // one set bit every 37 blocks, the samples are far apart
+    std::vector<U<8>> sparse(40000, U<8>::ZERO());
+    for (size_t i = 0; i < sparse.size(); i += 37) {
+        sparse[i].setBit(i % 64, true);
+    }
+    SuccinctBitVector<8> sbv(sparse);
+    for (size_t k = 0, i = 0; i < sparse.size(); i += 37, k++) {
+        ASSERT_EQ(sbv.select(k), i * 64 + i % 64) << k;
+        ASSERT_EQ(sbv.rank(i * 64 + i % 64), k);
+    }
+    EXPECT_EQ(sbv.select(sbv.bitCount()), sbv.length());
+
+    SuccinctBitVector<128> empty;
+    EXPECT_EQ(empty.length(), 0U);
+    EXPECT_EQ(empty.rank(0), 0U);
+    EXPECT_EQ(empty.select(0), 0U);
+}
+
+template<typename I>
+static void checkManipulation(uint64_t seed) {
+    constexpr size_t bits = sizeof (I) * 8;
+    for (int iter = 0; iter < 8; iter++) {
+        I v = randomValue<I>(seed);
+        I mask = randomBits<I>(seed, iter);
+        for (size_t d = 0; d < bits; d += 7) {
+            I l = v.rotateLeft(d);
+            I r = v.rotateRight(d);
+            for (size_t i = 0; i < bits; i++) {
+                ASSERT_EQ(l.getBit((i + d) % bits), v.getBit(i));
+                ASSERT_EQ(r.getBit(i), v.getBit((i + d) % bits));
+            }
+        }
+        EXPECT_EQ(v.rotateLeft(bits + 3), v.rotateLeft(3));
+        I rb = v.reverseBytes();
+        I rv = v.reverse();
+        for (size_t i = 0; i < sizeof (I); i++) {
+            ASSERT_EQ(rb.getByte(i), v.getByte(sizeof (I) - 1 - i));
+        }
+        for (size_t i = 0; i < bits; i++) {
+            ASSERT_EQ(rv.getBit(i), v.getBit(bits - 1 - i));
+        }
+        I c = v.compress(mask);
+        I e = v.expand(mask);
+        I refC = I::ZERO(), refE = I::ZERO();
+        size_t k = 0;
+        for (size_t i = 0; i < bits; i++) {
+            if (mask.getBit(i)) {
+                refC.setBit(k, v.getBit(i));
+                refE.setBit(i, v.getBit(k));
+                k++;
+            }
+        }
+        ASSERT_EQ(c, refC);
+        ASSERT_EQ(e, refE);
+        ASSERT_EQ(e.compress(mask), v.extract(0, k));
+        size_t offset = next(seed) % bits;
+        size_t width = next(seed) % (bits - offset + 1);
+        I x = v.extract(offset, width);
+        I f = randomValue<I>(seed);
+        I dp = v.deposit(offset, width, f);
+        for (size_t i = 0; i < bits; i++) {
+            ASSERT_EQ(x.getBit(i), i < width && v.getBit(offset + i));
+            bool inside = i >= offset && i < offset + width;
+            ASSERT_EQ(dp.getBit(i), inside ? f.getBit(i - offset) : v.getBit(i));
+        }
+    }
+}
+
+TEST(Bits, manipulation) {
+    checkManipulation<U<1>>(11);
+    checkManipulation<S<2>>(12);
+    checkManipulation<U<4>>(13);
+    checkManipulation<U<8>>(14);
+    checkManipulation<S<16>>(15);
+    checkManipulation<U<32>>(16);
+    checkManipulation<U<64>>(17);
+}
+
+TEST(Bits, manipulation_edge_cases) {
+    U<16> v = U<16>(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    EXPECT_EQ(v.reverseBytes(), U<16>(0x1032547698badcfeULL, 0xefcdab8967452301ULL));
+    EXPECT_EQ(v.rotateLeft(64), U<16>(0xfedcba9876543210ULL, 0x0123456789abcdefULL));
+    EXPECT_EQ(v.rotateRight(4), U<16>(0x00123456789abcdeULL, 0xffedcba987654321ULL));
+    EXPECT_EQ(v.extract(0, 128), v);
+    EXPECT_EQ(v.extract(60, 8), U<16>(0x00));
+    EXPECT_EQ(v.extract(64, 0), U<16>(0));
+    EXPECT_EQ(v.deposit(0, 128, U<16>(7)), U<16>(7));
+    EXPECT_EQ(S<8>(-1).extract(4, 8), S<8>(0xff));
+    // fields that reach past the top
+    EXPECT_EQ((~U<16>::ZERO()).extract(128, 4), U<16>(0));
+    EXPECT_EQ((~U<16>::ZERO()).extract(130, 4), U<16>(0));
+    EXPECT_EQ((~U<16>::ZERO()).extract(124, 8), U<16>(0xf));
+    EXPECT_EQ(U<4>(0xffffffffU).extract(40, 4), U<4>(0));
+    EXPECT_EQ(v.deposit(130, 4, U<16>(0xf)), v);
+    EXPECT_EQ(U<16>::ZERO().deposit(124, 8, ~U<16>::ZERO()), U<16>(0xfU) << 124);
+    EXPECT_EQ(U<4>::ZERO().deposit(28, 64, U<4>(0xffU)), U<4>(0xf0000000U));
+}
+
+TEST(Bits, constexpr_manipulation) {
+    constexpr U<16> v = U<16>(0x8000000000000001ULL, 0ULL);
+    static_assert(v.rotateLeft(1) == U<16>(2ULL, 1ULL), "constexpr rotate");
+    static_assert(v.reverse() == U<16>(0ULL, 0x8000000000000001ULL), "constexpr reverse");
+    static_assert(v.compress(U<16>(0xffULL, 0ULL)) == U<16>(1), "constexpr compress");
+    static_assert(U<16>(3).expand(v) == v, "constexpr expand");
+    EXPECT_EQ(v.rotateRight(1), U<16>(0x4000000000000000ULL, 0x8000000000000000ULL));
+}
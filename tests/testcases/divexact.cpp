@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<typename I>
+static I randomShifted(uint64_t &state) {
+    // short values and trailing zeros are the interesting ones
+    return (randomValue<I>(state) >> (next(state) % (sizeof (I) * 8))) << (next(state) % 8);
+}
+
+template<typename I>
+static void checkExact(uint64_t &state) {
+    for (int i = 0; i < 1000; i++) {
+        I d = randomShifted<I>(state);
+        I q = randomShifted<I>(state);
+        if (d.isZero()) {
+            continue;
+        }
+        I x = q * d;
+        // the product wrapped, q is not the quotient
+        if (x / d == q) {
+            ASSERT_EQ(divexact(x, d), q);
+            ASSERT_TRUE(is_divisible(x, d));
+        }
+        I y = randomShifted<I>(state);
+        ASSERT_EQ(is_divisible(y, d), (y % d).isZero());
+        ASSERT_EQ(is_divisible(I(x + I(1U)), d), (I(x + I(1U)) % d).isZero());
+    }
+}
+
+template<typename I>
+static void checkSigned(uint64_t &state) {
+    for (int i = 0; i < 1000; i++) {
+        I d = I(randomShifted<I>(state) >> 1);
+        I q = I(randomShifted<I>(state) >> (sizeof (I) * 4));
+        if (d.isZero()) {
+            continue;
+        }
+        d = next(state) & 1 ? -d : d;
+        q = next(state) & 1 ? -q : q;
+        I x = q * d;
+        if (x / d == q) {
+            ASSERT_EQ(divexact(x, d), q);
+            ASSERT_TRUE(is_divisible(x, d));
+        }
+        ASSERT_EQ(is_divisible(I(x - I(1)), d), (I(x - I(1)) % d).isZero());
+    }
+}
+
+TEST(DivExact, unsigned_values) {
+    uint64_t state = 0x452821e638d01377ULL;
+    checkExact<U<1>>(state);
+    checkExact<U<2>>(state);
+    checkExact<U<4>>(state);
+    checkExact<U<8>>(state);
+    checkExact<U<16>>(state);
+    checkExact<U<32>>(state);
+    checkExact<U<64>>(state);
+}
+
+TEST(DivExact, signed_values) {
+    uint64_t state = 0xbe5466cf34e90c6cULL;
+    checkSigned<S<2>>(state);
+    checkSigned<S<8>>(state);
+    checkSigned<S<16>>(state);
+    checkSigned<S<64>>(state);
+}
+
+TEST(DivExact, edge_cases) {
+    const U<32> max = ~U<32>::ZERO();
+    EXPECT_EQ(divexact(max, U<32>(1U)), max);
+    EXPECT_EQ(divexact(max, max), U<32>(1U));
+    EXPECT_EQ(divexact(U<32>::ZERO(), U<32>(12U)), U<32>::ZERO());
+    EXPECT_EQ(divexact(U<32>(1U) << 255, U<32>(1U) << 200), U<32>(1U) << 55);
+    EXPECT_EQ(divexact(S<16>(-12), S<16>(4)), S<16>(-3));
+    EXPECT_EQ(divexact(S<16>(-12), S<16>(-6)), S<16>(2));
+    EXPECT_TRUE(is_divisible(U<16>::ZERO(), U<16>::ZERO()));
+    EXPECT_FALSE(is_divisible(U<16>(1U), U<16>::ZERO()));
+    EXPECT_TRUE(is_divisible(max, U<32>(3U)));
+    EXPECT_TRUE(is_divisible(max, max));
+    EXPECT_FALSE(is_divisible(max - 1U, max));
+    EXPECT_FALSE(is_divisible(U<32>(1U) << 100, U<32>(3U) << 99));
+    EXPECT_TRUE(is_divisible(S<32>(U<32>(1U) << 255), S<32>(-2)));
+}
+
+TEST(DivExact, constexpr_divexact) {
+    constexpr U<32> q = U<32>(U<16>(0x0123456789abcdefULL, 3ULL));
+    constexpr U<32> d = U<32>(0xfedcba9876543210ULL);
+    static_assert(divexact(q * d, d) == q, "");
+    static_assert(is_divisible(q * d, d), "");
+    static_assert(!is_divisible(q * d + 1U, d), "");
+    static_assert(divexact(U<4>(91U), U<4>(7U)) == U<4>(13U), "");
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <sstream>
+#include <cstdint>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+static uint64_t randomDivisor(uint64_t &state) {
+    uint64_t d = next(state) >> (next(state) % 64);
+    return d == 0 ? 1 : d;
+}
+
+template<size_t size>
+static void checkShort(uint64_t &state) {
+    for (int i = 0; i < 500; i++) {
+        U<size> x = randomMixed<U<size>>(state);
+        uint64_t d = randomDivisor(state);
+        uint64_t r = 0;
+        U<size> q = divrem(x, d, &r);
+        ASSERT_LT(r, d);
+        ASSERT_EQ(q * d + r, x);
+        ASSERT_EQ(x / d, q);
+        ASSERT_EQ(x % d, U<size>(r));
+        // Integer divisor that fits in one limb
+        U<size> rem = U<size>::ZERO();
+        ASSERT_EQ(divrem(x, U<size>(d), &rem), q);
+        ASSERT_EQ(rem, U<size>(r));
+    }
+}
+
+TEST(Divide, return_type) {
+    uint64_t r64 = 0;
+    uint32_t r32 = 0;
+    ASSERT_EQ_TYPE(decltype(divrem(U<32>(), r64, &r64)), U<32>);
+    ASSERT_EQ_TYPE(decltype(divrem(U<16>(), r32, &r32)), U<16>);
+    ASSERT_EQ_TYPE(decltype(divrem(U<4>(), r32, &r32)), U<4>);
+    ASSERT_EQ_TYPE(decltype(U<64>() / 7), U<64>);
+    ASSERT_EQ_TYPE(decltype(S<64>() % 7), S<64>);
+}
+
+TEST(Divide, short_division) {
+    uint64_t state = 0x243f6a8885a308d3ULL;
+    checkShort<16>(state);
+    checkShort<32>(state);
+    checkShort<64>(state);
+    checkShort<128>(state);
+}
+
+TEST(Divide, short_division_edge_cases) {
+    U<32> max = ~U<32>::ZERO();
+    uint64_t r = 0;
+    EXPECT_EQ(divrem(max, uint64_t(1), &r), max);
+    EXPECT_EQ(r, 0ULL);
+    EXPECT_EQ(divrem(max, ~uint64_t(0), &r), U<32>(U<16>(1ULL, 1ULL), U<16>(1ULL, 1ULL)));
+    EXPECT_EQ(r, 0ULL);
+    EXPECT_EQ(divrem(U<32>::ZERO(), uint64_t(3), &r), U<32>::ZERO());
+    EXPECT_EQ(r, 0ULL);
+    EXPECT_EQ(divrem(U<16>(0ULL, 1ULL), uint64_t(0x8000000000000000ULL), &r), U<16>(2ULL));
+    EXPECT_EQ(r, 0ULL);
+    uint32_t r32 = 0;
+    EXPECT_EQ(divrem(U<16>(1000000007ULL, 0ULL), 1000000007U, &r32), U<16>(1ULL));
+    EXPECT_EQ(r32, 0U);
+    EXPECT_EQ(max % 1000000007U, max % U<32>(1000000007ULL));
+    EXPECT_EQ(divrem(U<4>(100U), 7U, &r32), U<4>(14U));
+    EXPECT_EQ(r32, 2U);
+}
+
+TEST(Divide, signed_native_divisor) {
+    uint64_t state = 0x13198a2e03707344ULL;
+    for (int i = 0; i < 500; i++) {
+        S<32> x = S<32>(randomMixed<U<32>>(state));
+        int64_t d = int64_t(randomDivisor(state) >> 1) | 1;
+        if (next(state) & 1) {
+            d = -d;
+        }
+        S<32> q = x / d;
+        S<32> r = x % d;
+        ASSERT_EQ(q * d + r, x);
+        ASSERT_EQ(q, x / S<32>(d));
+        ASSERT_EQ(r, x % S<32>(d));
+    }
+    EXPECT_EQ(S<16>(-7) / 2, S<16>(-3));
+    EXPECT_EQ(S<16>(-7) % 2, S<16>(-1));
+    EXPECT_EQ(S<16>(7) / -2, S<16>(-3));
+    EXPECT_EQ(S<16>(7) % -2, S<16>(1));
+    // negative divisor becomes a huge unsigned value
+    EXPECT_EQ(U<16>(7ULL) / -2, U<16>::ZERO());
+    EXPECT_EQ(U<16>(7ULL) % -2, U<16>(7ULL));
+}
+
+TEST(Divide, print) {
+    std::ostringstream out;
+    out << ~U<16>::ZERO();
+    EXPECT_EQ(out.str(), "340282366920938463463374607431768211455");
+}
+
+TEST(Divide, constexpr_short_division) {
+    constexpr U<32> x = U<32>(U<16>(0x0123456789abcdefULL, 0xfedcba9876543210ULL), U<16>(5ULL, 7ULL));
+    constexpr U<32> q = x / 1000000007ULL;
+    constexpr U<32> r = x % 1000000007ULL;
+    static_assert(q * 1000000007ULL + r == x, "");
+    static_assert(r < U<32>(1000000007ULL), "");
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+#include <vector>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+TEST(Dot, return_type) {
+    const int64_t *s = nullptr;
+    const uint64_t *u = nullptr;
+    const int32_t *s32 = nullptr;
+    ASSERT_EQ_TYPE(decltype(dot(s, s, 0)), S<16>);
+    ASSERT_EQ_TYPE(decltype(dot(u, u, 0)), U<16>);
+    ASSERT_EQ_TYPE(decltype(dot(s32, s32, 0)), S<8>);
+    ASSERT_EQ_TYPE(decltype(dot((const U<32>*) nullptr, (const U<32>*) nullptr, 0)), U<64>);
+    ASSERT_EQ_TYPE(decltype(fma(S<4>(), S<4>(), S<4>())), S<8>);
+    ASSERT_EQ_TYPE(decltype(fma(U<32>(), U<32>(), U<64>())), U<64>);
+}
+
+TEST(Dot, fma) {
+    uint64_t state = 0xc0ac29b7c97c50ddULL;
+    for (int i = 0; i < 500; i++) {
+        U<32> a = randomMixed<U<32>>(state), b = randomMixed<U<32>>(state);
+        U<32> c = randomMixed<U<32>>(state);
+        U<64> w = randomMixed<U<64>>(state);
+        ASSERT_EQ(fma(a, b, c), wmultiply(a, b) + U<64>(c));
+        ASSERT_EQ(fma(a, b, w), wmultiply(a, b) + w);
+        S<16> sa = S<16>(randomMixed<U<16>>(state)), sb = S<16>(randomMixed<U<16>>(state));
+        S<16> sc = S<16>(randomMixed<U<16>>(state));
+        ASSERT_EQ(fma(sa, sb, sc), wmultiply(sa, sb) + S<32>(sc));
+        S<2> na = S<2>(int16_t(next(state))), nb = S<2>(int16_t(next(state)));
+        ASSERT_EQ(fma(na, nb, na), S<4>(int32_t(int16_t(na)) * int16_t(nb) + int16_t(na)));
+    }
+}
+
+TEST(Dot, native) {
+    uint64_t state = 0x9216d5d98979fb1bULL;
+    for (int iter = 0; iter < 50; iter++) {
+        size_t n = next(state) % 100;
+        std::vector<int64_t> a(n), b(n);
+        std::vector<uint64_t> ua(n), ub(n);
+        std::vector<int32_t> a32(n), b32(n);
+        S<16> ref = S<16>::ZERO();
+        U<16> uref = U<16>::ZERO();
+        S<8> ref32 = S<8>::ZERO();
+        for (size_t i = 0; i < n; i++) {
+            a[i] = int64_t(next(state)) >> (next(state) % 64);
+            b[i] = int64_t(next(state)) >> (next(state) % 64);
+            ua[i] = next(state);
+            ub[i] = next(state);
+            a32[i] = int32_t(next(state));
+            b32[i] = int32_t(next(state));
+            ref += wmultiply(S<8>(a[i]), S<8>(b[i]));
+            uref += wmultiply(U<8>(ua[i]), U<8>(ub[i]));
+            ref32 += S<8>(int64_t(a32[i]) * b32[i]);
+        }
+        ASSERT_EQ(dot(a.data(), b.data(), n), ref);
+        ASSERT_EQ(dot(ua.data(), ub.data(), n), uref);
+        ASSERT_EQ(dot(a32.data(), b32.data(), n), ref32);
+    }
+    int64_t m[] = {INT64_MIN, INT64_MIN, INT64_MAX, -1};
+    EXPECT_EQ(dot(m, m, 4), wmultiply(S<8>(INT64_MIN), S<8>(INT64_MIN)) * 2 +
+            wmultiply(S<8>(INT64_MAX), S<8>(INT64_MAX)) + 1);
+}
+
+template<typename I>
+static void checkDot(uint64_t &state) {
+    using W = decltype(wmultiply(I(), I()));
+    for (int iter = 0; iter < 30; iter++) {
+        size_t n = next(state) % 40;
+        std::vector<I> a(n), b(n);
+        W ref = W::ZERO();
+        for (size_t i = 0; i < n; i++) {
+            a[i] = randomMixed<I>(state);
+            b[i] = randomMixed<I>(state);
+            ref += wmultiply(a[i], b[i]);
+        }
+        ASSERT_EQ(dot(a.data(), b.data(), n), ref);
+    }
+}
+
+TEST(Dot, integer) {
+    uint64_t state = 0x6a267e96ba7c9045ULL;
+    checkDot<U<2>>(state);
+    checkDot<S<4>>(state);
+    checkDot<U<8>>(state);
+    checkDot<S<8>>(state);
+    checkDot<U<32>>(state);
+    checkDot<S<32>>(state);
+}
+
+static constexpr int64_t qty[] = {3, -4, 5};
+static constexpr int64_t price[] = {7, 11, -13};
+
+TEST(Dot, constexpr_dot) {
+    static_assert(dot(qty, price, 3) == 21 - 44 - 65, "");
+    static_assert(fma(U<16>(~0ULL, ~0ULL), U<16>(~0ULL, ~0ULL), U<32>(U<16>(~0ULL, ~0ULL))) ==
+            wmultiply(U<16>(~0ULL, ~0ULL), U<16>(~0ULL, ~0ULL)) + U<16>(~0ULL, ~0ULL), "");
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace JIO;
+
+// any finite double, subnormals included
+static double randomDouble(uint64_t &state) {
+    for (;;) {
+        uint64_t bits = next(state);
+        if (next(state) % 4 == 0) {
+            // small exponent range, so that the terms interact
+            bits = (bits & 0x800fffffffffffffULL) | ((1000 + next(state) % 50) << 52);
+        }
+        double out;
+        std::memcpy(&out, &bits, sizeof (out));
+        if (std::isfinite(out)) {
+            return out;
+        }
+    }
+}
+
+static double p2(int e) {
+    return std::ldexp(1.0, e);
+}
+
+static double sum(const std::vector<double> &v) {
+    ExactSum<> acc;
+    for (double x : v) {
+        acc.add(x);
+    }
+    return acc.result();
+}
+
+static void expectSame(double a, double b) {
+    EXPECT_EQ(std::memcmp(&a, &b, sizeof (a)), 0) << a << " " << b;
+}
+
+TEST(ExactSum, cancellation) {
+    expectSame(sum({1e100, 1.0, -1e100}), 1.0);
+    expectSame(sum({1e308, 1e308, -1e308, -1e308, p2(-1074)}), p2(-1074));
+    expectSame(sum({0.1, 0.2, -0.3}), p2(-55));
+    expectSame(sum({}), 0.0);
+    expectSame(sum({-0.0}), 0.0);
+    // overflow of the result only
+    expectSame(sum({1.7e308, 1.7e308}), std::numeric_limits<double>::infinity());
+    expectSame(sum({1.7e308, 1.7e308, -1.7e308}), 1.7e308);
+}
+
+TEST(ExactSum, value) {
+    ExactSum<> acc;
+    acc.add(p2(-1074));
+    EXPECT_EQ(acc.value(), S<512>(1));
+    acc.add(-1.0);
+    EXPECT_EQ(acc.value(), S<512>(1) - (S<512>(1) << 1074));
+    acc.add(std::numeric_limits<double>::max());
+    EXPECT_TRUE(acc.isFinite());
+}
+
+TEST(ExactSum, two_terms) {
+    // a single addition is correctly rounded
+    uint64_t state = 0x452821e638d01377ULL;
+    for (int i = 0; i < 20000; i++) {
+        double a = randomDouble(state), b = randomDouble(state);
+        ExactSum<> acc;
+        acc += a;
+        acc += b;
+        expectSame(acc.result(), a + b);
+    }
+}
+
+TEST(ExactSum, rounding_error) {
+    // s = fl(a + b), then a + b - s is a double (TwoSum)
+    uint64_t state = 0xbe5466cf34e90c6cULL;
+    for (int i = 0; i < 20000; i++) {
+        double a = randomDouble(state), b = randomDouble(state);
+        double s = a + b;
+        if (!std::isfinite(s)) {
+            continue;
+        }
+        double bb = s - a;
+        double err = (a - (s - bb)) + (b - bb);
+        expectSame(sum({a, b, -s}) + 0.0, err + 0.0);
+    }
+}
+
+TEST(ExactSum, ties_to_even) {
+    expectSame(sum({1.0, p2(-53)}), 1.0);
+    expectSame(sum({1.0, p2(-53), p2(-1074)}), 1.0 + p2(-52));
+    expectSame(sum({1.0 + p2(-52), p2(-53)}), 1.0 + p2(-51));
+    expectSame(sum({p2(-1022), -p2(-1074)}), p2(-1022) - p2(-1074));
+}
+
+TEST(ExactSum, order_and_merge) {
+    uint64_t state = 0xc0ac29b7c97c50ddULL;
+    std::vector<double> v(3000);
+    for (double &x : v) {
+        x = randomDouble(state);
+    }
+    double ref = sum(v);
+    std::reverse(v.begin(), v.end());
+    expectSame(sum(v), ref);
+    std::sort(v.begin(), v.end());
+    expectSame(sum(v), ref);
+    ExactSum<> parts[4];
+    for (size_t i = 0; i < v.size(); i++) {
+        parts[i % 4].add(v[i]);
+    }
+    parts[0].merge(parts[1]);
+    parts[2] += parts[3];
+    parts[0] += parts[2];
+    expectSame(parts[0].result(), ref);
+}
+
+TEST(ExactSum, special_values) {
+    const double inf = std::numeric_limits<double>::infinity();
+    expectSame(sum({1.0, inf, -5.0}), inf);
+    expectSame(sum({-inf, 1e308}), -inf);
+    EXPECT_TRUE(std::isnan(sum({inf, -inf})));
+    EXPECT_TRUE(std::isnan(sum({1.0, std::nan("")})));
+    ExactSum<> a, b;
+    b.add(inf);
+    EXPECT_FALSE(a.merge(b).isFinite());
+}
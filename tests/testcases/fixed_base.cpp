@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<size_t size, size_t window>
+static void checkPow(uint64_t &state) {
+    using I = U<size>;
+    for (int i = 0; i < 3; i++) {
+        I m = randomValue<I>(state) | 1U;
+        I g = randomValue<I>(state);
+        Montgomery<size> ctx(m);
+        const FixedBasePow<size, window> fb(g, m);
+        ASSERT_EQ(fb.modulus(), m);
+        for (int j = 0; j < 20; j++) {
+            I e = randomValue<I>(state) >> (next(state) % (size * 8));
+            ASSERT_EQ(fb.pow(e), ctx.from(ctx.pow(ctx.to(g), e)));
+        }
+        ASSERT_EQ(fb.pow(I::ZERO()), I(1U) % m);
+        ASSERT_EQ(fb.pow(~I::ZERO()), ctx.from(ctx.pow(ctx.to(g), ~I::ZERO())));
+        U<8> e = randomValue<U<8>>(state);
+        ASSERT_EQ(fb.pow(e), ctx.from(ctx.pow(ctx.to(g), e)));
+    }
+}
+
+TEST(FixedBasePow, windows) {
+    uint64_t state = 0x510e527fade682d1ULL;
+    checkPow<8, 1>(state);
+    checkPow<8, 3>(state);
+    checkPow<16, 4>(state);
+    checkPow<32, 5>(state);
+    checkPow<32, 8>(state);
+    checkPow<64, 4>(state);
+}
+
+TEST(FixedBasePow, known_values) {
+    // 3 generates the multiplicative group of 998244353
+    FixedBasePow<8> fb(U<8>(3U), U<8>(998244353U));
+    EXPECT_EQ(fb.pow(U<8>(998244352U)), U<8>(1U));
+    EXPECT_EQ(fb.pow(U<8>(499122176U)), U<8>(998244352U));
+    EXPECT_EQ(fb.pow(U<8>(5U)), U<8>(243U));
+    const U<32> p = (U<32>(1U) << 255) - 19U;
+    FixedBasePow<32, 6> fb2(U<32>(2U), p);
+    EXPECT_EQ(fb2.pow(U<32>(255U)), U<32>(19U));
+    EXPECT_EQ(fb2.pow(p - 1U), U<32>(1U));
+}
+
+TEST(FixedBasePow, large_table) {
+    // 2^12 - 1 values of 64 bytes for each of the 43 windows, 11 MB
+    // that would not fit on the stack
+    const U<64> m = (U<64>(1U) << 511) - 187U;
+    const FixedBasePow<64, 12> fb(U<64>(3U), m);
+    Montgomery<64> ctx(m);
+    const U<64> e = ~U<64>::ZERO() / 7U;
+    EXPECT_EQ(fb.pow(e), ctx.from(ctx.pow(ctx.to(U<64>(3U)), e)));
+}
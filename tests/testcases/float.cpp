@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+using namespace JIO;
+
+template<typename I>
+static I randomRuns(uint64_t &state) {
+    I v = randomLength<I>(state);
+    // long runs of ones and zeros hit the ties
+    if (next(state) % 4 == 0) {
+        v &= ~I::ZERO() << (next(state) % (sizeof (I) * 8));
+    }
+    return v;
+}
+
+// reference: exact sum of 32 bit chunks, rounded once
+template<size_t size>
+static double refDouble(const U<size> &v) {
+    ExactSum<> acc;
+    for (size_t i = 0; i < size * 8; i += 32) {
+        acc.add(std::ldexp(double(uint32_t(v >> i)), int(i)));
+    }
+    return acc.result();
+}
+
+template<size_t size>
+static void checkToDouble(uint64_t &state) {
+    for (int i = 0; i < 2000; i++) {
+        U<size> x = randomRuns<U<size>>(state);
+        double d = refDouble(x);
+        ASSERT_EQ(double(x), d);
+        ASSERT_EQ(double(S<size>(-S<size>(x >> 1))), -refDouble(U<size>(x >> 1)));
+    }
+}
+
+TEST(Float, to_double) {
+    uint64_t state = 0x3f84d5b5b5470917ULL;
+    checkToDouble<16>(state);
+    checkToDouble<32>(state);
+    checkToDouble<128>(state);
+    EXPECT_EQ(double(U<32>::ZERO()), 0.0);
+    EXPECT_EQ(double(S<4>(-7)), -7.0);
+    EXPECT_EQ(double(U<8>(~0ULL)), 18446744073709551616.0);
+    // ties to even
+    U<16> p53 = U<16>(1ULL << 53);
+    EXPECT_EQ(double(p53 + 1U), 9007199254740992.0);
+    EXPECT_EQ(double(p53 + 3U), 9007199254740996.0);
+    EXPECT_EQ(double((p53 + 1U) << 60), std::ldexp(1.0, 113));
+    EXPECT_EQ(double(((p53 + 1U) << 60) + 1U), std::ldexp(1.0, 113) + std::ldexp(1.0, 61));
+    // the minimum of a signed type
+    EXPECT_EQ(double(S<32>(U<32>(1U) << 255)), -std::ldexp(1.0, 255));
+    // out of range
+    EXPECT_EQ(double(~U<256>::ZERO()), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(float(U<32>(1U) << 200), std::numeric_limits<float>::infinity());
+}
+
+#if defined(__SIZEOF_INT128__)
+
+TEST(Float, int128) {
+    __extension__ typedef unsigned __int128 u128;
+    __extension__ typedef __int128 s128;
+    uint64_t state = 0x0d95748f728eb658ULL;
+    for (int i = 0; i < 20000; i++) {
+        U<16> x = randomRuns<U<16>>(state);
+        u128 n = (u128(uint64_t(x >> 64)) << 64) | uint64_t(x);
+        ASSERT_EQ(float(x), float(n));
+        ASSERT_EQ(double(x), double(n));
+        ASSERT_EQ((long double) x, (long double) n);
+        ASSERT_EQ(double(S<16>(x)), double(s128(n)));
+        double d = std::ldexp(double(next(state)), int(next(state) % 64));
+        if (next(state) & 1) {
+            d = -d;
+        }
+        u128 t = u128(s128(d));
+        ASSERT_EQ(S<16>(d), S<16>(U<16>(uint64_t(t), uint64_t(t >> 64))));
+        float f = float(d) * 0.75f;
+        t = u128(s128(f));
+        ASSERT_EQ(S<16>(f), S<16>(U<16>(uint64_t(t), uint64_t(t >> 64))));
+    }
+}
+#endif
+
+TEST(Float, from_floating) {
+    EXPECT_EQ(U<16>(0.99), U<16>::ZERO());
+    EXPECT_EQ(S<16>(-1.5), S<16>(-1));
+    EXPECT_EQ(S<2>(-32768.0), S<2>(int16_t(-32768)));
+    EXPECT_EQ(U<64>(std::ldexp(1.0, 300)), U<64>(1U) << 300);
+    EXPECT_EQ(S<64>(-std::ldexp(3.0, 400)), -(S<64>(3) << 400));
+    EXPECT_EQ(U<16>(1e30), U<16>(1000000000000ULL) * U<16>(1000000000000000000ULL) + 19884624838656ULL);
+    EXPECT_EQ(U<16>(9007199254740993.0), U<16>(9007199254740992ULL));
+    // modulo 2^bits, like the integer conversions
+    EXPECT_EQ(U<16>(std::ldexp(1.0, 200)), U<16>::ZERO());
+    EXPECT_EQ(U<4>(std::ldexp(1.0, 32) + 5), U<4>(5U));
+    EXPECT_EQ(U<32>(std::nan("")), U<32>::ZERO());
+    EXPECT_EQ(S<32>(-std::numeric_limits<double>::infinity()), S<32>::ZERO());
+    // 64 bit mantissa of x87 long double, if any
+    long double big = std::ldexp((long double) (~0ULL >> (64 - std::numeric_limits<long double>::digits)), 10);
+    EXPECT_EQ((long double) U<16>(big), big);
+}
+
+TEST(Float, round_trip) {
+    uint64_t state = 0x2ffd72dbd01adfb7ULL;
+    for (int i = 0; i < 20000; i++) {
+        double d = std::ldexp(double(next(state) >> 11), int(next(state) % 900));
+        ASSERT_EQ(double(U<128>(d)), d);
+        ASSERT_EQ(double(S<128>(-d)), -d);
+        float f = float(d);
+        if (std::isfinite(f)) {
+            ASSERT_EQ(float(U<128>(f)), f);
+        }
+        // 53 significant bits are exact
+        U<32> x = U<32>(next(state) >> 11) << (next(state) % 200);
+        ASSERT_EQ(U<32>(double(x)), x);
+    }
+}
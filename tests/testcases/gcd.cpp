@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+template<size_t size>
+static U<size> refGcd(U<size> a, U<size> b) {
+    while (!b.isZero()) {
+        U<size> r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+template<size_t size>
+static void checkGcd(uint64_t &state) {
+    for (int i = 0; i < 300; i++) {
+        U<size> a = randomLength<U<size>>(state);
+        U<size> b = randomLength<U<size>>(state);
+        if (next(state) % 4 == 0) {
+            // a large common factor
+            U<size> c = randomLength<U<size>>(state) >> (size * 4);
+            a = (a >> (size * 4)) * c;
+            b = (b >> (size * 4)) * c;
+        }
+        U<size> g = gcd(a, b);
+        ASSERT_EQ(g, refGcd(a, b));
+        S<size> x = S<size>::ZERO(), y = S<size>::ZERO();
+        ASSERT_EQ(xgcd(a, b, &x, &y), g);
+        ASSERT_EQ(a * U<size>(x) + b * U<size>(y), g);
+        if (!g.isZero()) {
+            // the cofactors of Euclid's algorithm are small
+            ASSERT_LE(U<size>(x.isNegative() ? -x : x), b / 2 + 1);
+            ASSERT_LE(U<size>(y.isNegative() ? -y : y), a / 2 + 1);
+            ASSERT_EQ(lcm(a, b), a / g * b);
+        }
+    }
+}
+
+TEST(Gcd, return_type) {
+    ASSERT_EQ_TYPE(decltype(gcd(U<32>(), U<32>())), U<32>);
+    ASSERT_EQ_TYPE(decltype(lcm(S<4>(), S<4>())), S<4>);
+    ASSERT_EQ_TYPE(decltype(xgcd(S<16>(), S<16>(), nullptr, nullptr)), S<16>);
+    ASSERT_EQ_TYPE(decltype(modinv(U<64>(), U<64>())), U<64>);
+}
+
+TEST(Gcd, random) {
+    uint64_t state = 0x8e79dcb0603a180eULL;
+    checkGcd<2>(state);
+    checkGcd<8>(state);
+    checkGcd<16>(state);
+    checkGcd<32>(state);
+    checkGcd<64>(state);
+    checkGcd<128>(state);
+}
+
+TEST(Gcd, edge_cases) {
+    EXPECT_EQ(gcd(U<32>::ZERO(), U<32>::ZERO()), U<32>::ZERO());
+    EXPECT_EQ(gcd(U<32>(12U), U<32>::ZERO()), U<32>(12U));
+    EXPECT_EQ(gcd(U<32>::ZERO(), U<32>(12U)), U<32>(12U));
+    EXPECT_EQ(gcd(~U<32>::ZERO(), ~U<32>::ZERO()), ~U<32>::ZERO());
+    EXPECT_EQ(gcd(U<32>(1U) << 200, U<32>(3U) << 100), U<32>(1U) << 100);
+    EXPECT_EQ(gcd(S<32>(-12), S<32>(18)), S<32>(6));
+    EXPECT_EQ(lcm(S<8>(-4), S<8>(6)), S<8>(12));
+    EXPECT_EQ(lcm(U<16>(4U), U<16>::ZERO()), U<16>::ZERO());
+    // consecutive Fibonacci numbers, the longest chain of quotients
+    U<32> f0 = U<32>(1U), f1 = U<32>(1U);
+    while ((f1 >> 250).isZero()) {
+        U<32> t = f0 + f1;
+        f0 = f1;
+        f1 = t;
+    }
+    S<32> x = S<32>::ZERO(), y = S<32>::ZERO();
+    EXPECT_EQ(xgcd(f1, f0, &x, &y), U<32>(1U));
+    EXPECT_EQ(f1 * U<32>(x) + f0 * U<32>(y), U<32>(1U));
+}
+
+TEST(Gcd, signed_xgcd) {
+    uint64_t state = 0x7b54a41dc25a59b5ULL;
+    for (int i = 0; i < 500; i++) {
+        S<32> a = S<32>(randomLength<U<32>>(state));
+        S<32> b = S<32>(randomLength<U<32>>(state));
+        S<32> x = S<32>::ZERO(), y = S<32>::ZERO();
+        S<32> g = xgcd(a, b, &x, &y);
+        ASSERT_FALSE(g.isNegative());
+        ASSERT_EQ(g, gcd(a, b));
+        ASSERT_EQ(a * x + b * y, g);
+    }
+    S<16> x = S<16>::ZERO();
+    EXPECT_EQ(xgcd(S<16>(-15), S<16>(6), &x, nullptr), S<16>(3));
+    EXPECT_EQ(x, S<16>(-1));
+}
+
+TEST(Gcd, modinv) {
+    uint64_t state = 0x2ba9c55d741831f6ULL;
+    // 2^255 - 19
+    U<32> p = (U<32>(1U) << 255) - 19U;
+    for (int i = 0; i < 300; i++) {
+        U<32> a = randomLength<U<32>>(state) % p;
+        if (a.isZero()) {
+            continue;
+        }
+        U<32> inv = modinv(a, p);
+        ASSERT_EQ(U<32>(wmultiply(a, inv) % U<64>(p)), U<32>(1U));
+        U<8> m = U<8>(next(state) | 1);
+        U<8> b = U<8>(next(state));
+        U<8> binv = modinv(b, m);
+        if (gcd(b, m) == 1U) {
+            ASSERT_EQ(U<8>(wmultiply(b % m, binv) % U<16>(m)), U<8>(1U) % m);
+            ASSERT_LT(binv, m);
+        } else {
+            ASSERT_EQ(binv, U<8>::ZERO());
+        }
+    }
+    EXPECT_EQ(modinv(U<4>(3U), U<4>(7U)), U<4>(5U));
+    EXPECT_EQ(modinv(U<4>(4U), U<4>(8U)), U<4>::ZERO());
+}
+
+TEST(Gcd, constexpr_gcd) {
+    static_assert(gcd(U<32>(1U) << 100, U<32>(48U)) == 16U, "");
+    static_assert(gcd(U<8>(1071U), U<8>(462U)) == 21U, "");
+    static_assert(modinv(U<16>(3U), U<16>(11U)) == 4U, "");
+    static_assert(lcm(S<32>(-6), S<32>(10)) == 30, "");
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<typename I>
+static void checkLazy(uint64_t &state) {
+    using W = Integer<sizeof (I) * 2, I(-1) < I(0)>;
+    for (int i = 0; i < 300; i++) {
+        I a = randomMixed<I>(state), b = randomMixed<I>(state);
+        I c = randomMixed<I>(state), d = randomMixed<I>(state);
+        I e = randomMixed<I>(state);
+        I r = lazy(a) * b + lazy(c) * d - e;
+        ASSERT_EQ(r, a * b + c * d - e);
+        r = e - lazy(a) * b;
+        ASSERT_EQ(r, e - a * b);
+        r = lazy(a) + b - lazy(c) * d;
+        ASSERT_EQ(r, a + b - c * d);
+        r = -(lazy(a) * b) + e;
+        ASSERT_EQ(r, e - a * b);
+        // double width result is exact
+        W w = lazy(a) * b + lazy(c) * d - e;
+        ASSERT_EQ(w, W(a) * W(b) + W(c) * W(d) - W(e));
+        W acc = W(e);
+        acc += lazy(a) * b;
+        acc -= lazy(c) * d;
+        ASSERT_EQ(acc, W(e) + W(a) * W(b) - W(c) * W(d));
+        I acc2 = e;
+        acc2 += lazy(a) * b + lazy(c) * d;
+        ASSERT_EQ(acc2, e + a * b + c * d);
+    }
+}
+
+TEST(Lazy, return_type) {
+    U<32> a;
+    ASSERT_TRUE((std::is_convertible<decltype(lazy(a) * a + a), U<32>>()));
+    ASSERT_TRUE((std::is_convertible<decltype(lazy(a) * a + a), U<64>>()));
+}
+
+TEST(Lazy, fused) {
+    uint64_t state = 0x452821e638d01377ULL;
+    checkLazy<U<8>>(state);
+    checkLazy<U<16>>(state);
+    checkLazy<U<32>>(state);
+    checkLazy<S<32>>(state);
+    checkLazy<U<64>>(state);
+    checkLazy<S<128>>(state);
+}
+
+TEST(Lazy, edge_cases) {
+    U<32> max = ~U<32>::ZERO();
+    U<64> w = lazy(max) * max + lazy(max) * max;
+    EXPECT_EQ(w, wmultiply(max, max) << 1);
+    S<32> min = S<32>(U<32>(1U) << 255);
+    S<64> sw = lazy(min) * min - min;
+    EXPECT_EQ(sw, S<64>(min) * S<64>(min) - S<64>(min));
+    S<32> m1 = S<32>(-1);
+    S<64> sm = lazy(m1) * min;
+    EXPECT_EQ(sm, -S<64>(min));
+}
+
+static constexpr U<16> mac(const U<16> &a, const U<16> &b, const U<16> &c) {
+    U<16> out = lazy(a) * b - c;
+    return out;
+}
+
+TEST(Lazy, constexpr_lazy) {
+    constexpr U<16> a = U<16>(~0ULL, 5ULL);
+    static_assert(mac(a, U<16>(3U), U<16>(7U)) == a * 3U - 7U, "");
+    static_assert(mac(U<16>(2U), U<16>(3U), U<16>(7U)) == ~U<16>::ZERO(), "");
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<size_t size>
+static void checkChain(const U<size> &m, uint64_t &state) {
+    using I = U<size>;
+    using W = U<size * 2>;
+    ASSERT_TRUE(PseudoMersenne<size>::accepts(m));
+    PseudoMersenne<size> pm(m);
+    ASSERT_EQ(pm.modulus(), m);
+    const size_t k = size * 8 - m.numberOfLeadingZeros();
+    for (int i = 0; i < 100; i++) {
+        // lazy values are below 2^k
+        I a = pm.reduce(randomValue<I>(state));
+        I b = randomValue<I>(state) >> (size * 8 - k);
+        I ref = a;
+        I lazy = a;
+        for (int j = 0; j < 20; j++) {
+            switch (next(state) % 4) {
+                case 0:
+                    lazy = pm.mul(lazy, b);
+                    ref = I(wmultiply(ref, b % m) % W(m));
+                    break;
+                case 1:
+                    lazy = pm.sqr(lazy);
+                    ref = I(wmultiply(ref, ref) % W(m));
+                    break;
+                case 2:
+                    lazy = pm.add(lazy, b);
+                    ref = I((W(ref) + W(b % m)) % W(m));
+                    break;
+                default:
+                    lazy = pm.sub(lazy, b);
+                    ref = I((W(ref) + W(m) - W(b % m)) % W(m));
+            }
+            ASSERT_TRUE(k == size * 8 || (lazy >> k).isZero());
+        }
+        ASSERT_EQ(pm.reduce(lazy), ref);
+    }
+}
+
+TEST(PseudoMersenne, chains) {
+    uint64_t state = 0x1f14b0e74d4ad67fULL;
+    checkChain((U<32>(1U) << 255) - 19U, state);
+    checkChain((U<16>(1U) << 127) - 1U, state);
+    checkChain(U<8>((1ULL << 61) - 1), state);
+    // secp256k1, c has 33 bits
+    checkChain(U<32>::ZERO() - (U<32>(1U) << 32) - 977U, state);
+    checkChain((U<128>(1U) << 521) - 1U, state);
+}
+
+TEST(PseudoMersenne, accepts) {
+    EXPECT_TRUE(PseudoMersenne<32>::accepts((U<32>(1U) << 255) - 19U));
+    EXPECT_FALSE(PseudoMersenne<8>::accepts(U<8>(998244353U)));
+    EXPECT_FALSE(PseudoMersenne<32>::accepts(U<32>(1U) << 255));
+    EXPECT_FALSE(PseudoMersenne<32>::accepts((U<32>(1U) << 255) + 19U));
+    EXPECT_FALSE(PseudoMersenne<16>::accepts((U<16>(1U) << 127) - (U<16>(1U) << 64)));
+}
+
+TEST(PseudoMersenne, full_width) {
+    // k equals the width, 2^k itself does not fit
+    const U<16> m = U<16>::ZERO() - 159U;
+    PseudoMersenne<16> pm(m);
+    const U<16> x = m - 1U;
+    EXPECT_EQ(pm.reduce(pm.mul(x, x)), U<16>(1U));
+    EXPECT_EQ(pm.reduce(~U<16>::ZERO()), U<16>(158U));
+    EXPECT_EQ(pm.reduce(pm.add(x, x)), m - 2U);
+    EXPECT_EQ(pm.reduce(pm.sub(U<16>::ZERO(), U<16>(1U))), m - 1U);
+}
+
+struct P127 {
+
+    constexpr static U<16> value() noexcept {
+        return (U<16>(1U) << 127) - 1U;
+    }
+};
+
+TEST(PseudoMersenne, modint) {
+    using MI = ModInt<16, P127>;
+    uint64_t state = 0x3c6ef372fe94f82bULL;
+    for (int i = 0; i < 500; i++) {
+        U<16> a = randomValue<U<16>>(state), b = randomValue<U<16>>(state);
+        ASSERT_EQ((MI(a) * MI(b)).value(), U<16>(wmultiply(a, b) % U<32>(P127::value())));
+    }
+    constexpr PseudoMersenne<32> pm((U<32>(1U) << 255) - 19U);
+    static_assert(pm.reduce(pm.mul(U<32>(1U) << 200, U<32>(1U) << 100)) == U<32>(19U) << 45, "");
+    static_assert(MI(3U).pow(P127::value() - 1U) == MI::ONE(), "");
+}
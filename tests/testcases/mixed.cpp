@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+template<typename I>
+static I randomBoundary(uint64_t &state) {
+    I v = I::ZERO();
+    // values near the carry boundaries are the interesting ones
+    switch (next(state) % 4) {
+        case 0:
+            v = ~I::ZERO();
+            break;
+        case 1:
+            break;
+        default:
+            v = randomValue<I>(state);
+    }
+    size_t bytes = next(state) % sizeof (I);
+    for (size_t i = 0; i < bytes; i++) {
+        v.setByte(i, next(state));
+    }
+    return v;
+}
+
+template<typename W, typename N>
+static void checkMixed(uint64_t &state) {
+    using R = decltype(W() + N());
+    for (int i = 0; i < 1000; i++) {
+        W a = randomBoundary<W>(state);
+        N b = randomBoundary<N>(state);
+        ASSERT_EQ(a + b, R(a) + R(b));
+        ASSERT_EQ(b + a, R(a) + R(b));
+        ASSERT_EQ(a - b, R(a) - R(b));
+        ASSERT_EQ(b - a, R(b) - R(a));
+        ASSERT_EQ(a * b, R(a) * R(b));
+        ASSERT_EQ(b * a, R(a) * R(b));
+        ASSERT_EQ(a == b, R(a) == R(b));
+        ASSERT_EQ(a != b, R(a) != R(b));
+        ASSERT_EQ(a < b, R(a) < R(b));
+        ASSERT_EQ(a > b, R(a) > R(b));
+        ASSERT_EQ(a <= b, R(a) <= R(b));
+        ASSERT_EQ(a >= b, R(a) >= R(b));
+        ASSERT_EQ(b < a, R(b) < R(a));
+        ASSERT_EQ(b >= a, R(b) >= R(a));
+        // equal values in the low part
+        W c = R(b);
+        ASSERT_EQ(c == b, R(c) == R(b));
+        ASSERT_EQ(c < b, R(c) < R(b));
+        ASSERT_EQ(b > c, R(b) > R(c));
+    }
+}
+
+template<typename W, typename T>
+static void checkNative(uint64_t &state) {
+    using R = decltype(W() + T());
+    for (int i = 0; i < 1000; i++) {
+        W a = randomBoundary<W>(state);
+        T b = T(next(state) >> (next(state) % 64));
+        if (next(state) % 8 == 0) {
+            b = T(-b);
+        }
+        ASSERT_EQ(a + b, R(a) + R(b));
+        ASSERT_EQ(b + a, R(a) + R(b));
+        ASSERT_EQ(a - b, R(a) - R(b));
+        ASSERT_EQ(b - a, R(b) - R(a));
+        ASSERT_EQ(a * b, R(a) * R(b));
+        ASSERT_EQ(a == b, R(a) == R(b));
+        ASSERT_EQ(a < b, R(a) < R(b));
+        ASSERT_EQ(b < a, R(b) < R(a));
+        ASSERT_EQ(a >= b, R(a) >= R(b));
+        W c = a;
+        c += b;
+        ASSERT_EQ(c, R(a) + R(b));
+        c -= b;
+        ASSERT_EQ(c, a);
+        c *= b;
+        ASSERT_EQ(c, R(a) * R(b));
+    }
+}
+
+template<typename W, typename N>
+static void checkCompound(uint64_t &state) {
+    for (int i = 0; i < 1000; i++) {
+        W a = randomBoundary<W>(state);
+        N b = randomBoundary<N>(state);
+        W c = a;
+        c += b;
+        ASSERT_EQ(c, a + W(b));
+        c = a;
+        c -= b;
+        ASSERT_EQ(c, a - W(b));
+        c = a;
+        c *= b;
+        ASSERT_EQ(c, a * W(b));
+        size_t d = next(state) % (sizeof (W) * 8);
+        c = a;
+        c <<= d;
+        ASSERT_EQ(c, a << d);
+        c = a;
+        c >>= U<2>(d);
+        ASSERT_EQ(c, a >> d);
+        // aliased operands
+        c = a;
+        c += c;
+        ASSERT_EQ(c, a + a);
+        c = a;
+        c -= c;
+        ASSERT_EQ(c, W::ZERO());
+        c = a;
+        c *= c;
+        ASSERT_EQ(c, a * a);
+    }
+}
+
+template<typename W, typename N>
+static constexpr W compound(W v, const N &x) {
+    v += x;
+    v *= x;
+    v -= x;
+    v <<= 3;
+    v >>= 1;
+    return v;
+}
+
+TEST(Mixed, return_type) {
+    ASSERT_EQ_TYPE(decltype(U<64>() + uint64_t()), U<64>);
+    ASSERT_EQ_TYPE(decltype(int() - S<32>()), S<32>);
+    ASSERT_EQ_TYPE(decltype(U<16>() * S<64>()), S<64>);
+    ASSERT_EQ_TYPE(decltype(S<32>() + U<8>()), S<32>);
+}
+
+TEST(Mixed, narrow_integer) {
+    uint64_t state = 0xa4093822299f31d0ULL;
+    checkMixed<U<64>, U<8>>(state);
+    checkMixed<U<64>, S<8>>(state);
+    checkMixed<S<64>, U<4>>(state);
+    checkMixed<S<64>, S<2>>(state);
+    checkMixed<U<64>, U<16>>(state);
+    checkMixed<S<128>, S<32>>(state);
+    checkMixed<U<32>, S<16>>(state);
+    checkMixed<S<16>, S<1>>(state);
+}
+
+TEST(Mixed, native) {
+    uint64_t state = 0x082efa98ec4e6c89ULL;
+    checkNative<U<128>, uint64_t>(state);
+    checkNative<U<128>, int64_t>(state);
+    checkNative<S<64>, int32_t>(state);
+    checkNative<S<32>, uint16_t>(state);
+    checkNative<U<16>, int8_t>(state);
+}
+
+TEST(Mixed, compound) {
+    uint64_t state = 0xbe5466cf34e90c6cULL;
+    checkCompound<U<64>, U<64>>(state);
+    checkCompound<S<64>, S<64>>(state);
+    checkCompound<U<64>, S<8>>(state);
+    checkCompound<S<64>, U<16>>(state);
+    checkCompound<S<32>, S<64>>(state);
+    checkCompound<U<16>, U<2>>(state);
+    checkCompound<S<8>, S<32>>(state);
+}
+
+TEST(Mixed, carry) {
+    U<64> max = ~U<64>::ZERO();
+    EXPECT_EQ(max + 1U, U<64>::ZERO());
+    EXPECT_EQ(U<64>::ZERO() - 1U, max);
+    EXPECT_EQ(max + -1, max - 1U);
+    EXPECT_EQ(U<64>(U<32>(~U<16>::ZERO(), U<16>::ZERO())) + 1, U<64>(U<32>(U<16>::ZERO(), U<16>(1ULL))));
+    S<32> smin = S<32>(U<32>(1U) << 255);
+    S<32> smax = ~smin;
+    EXPECT_EQ(smin - 1, smax);
+    EXPECT_EQ(smax + int64_t(INT64_MIN), smax - U<8>(1ULL << 63));
+    EXPECT_TRUE(S<32>(-1) < 0);
+    EXPECT_TRUE(U<32>(-1) > 0);
+    EXPECT_TRUE(U<32>(-1) == -1);
+    EXPECT_TRUE(smin < INT64_MIN);
+}
+
+TEST(Mixed, constexpr_mixed) {
+    constexpr U<32> a = ~U<32>::ZERO();
+    static_assert(a + 1U == 0, "");
+    static_assert(a * 3U == a - 2U, "");
+    static_assert(a * U<16>(3ULL) == a - 2U, "");
+    static_assert(S<32>(-5) * -3 == 15, "");
+    static_assert(S<32>(-5) < U<8>(1ULL), "");
+    static_assert(compound(a, 1U) == (a << 3) >> 1, "");
+    static_assert(compound(S<32>(-3), S<8>(-2)) == S<32>(48), "");
+}
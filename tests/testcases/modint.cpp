@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+struct P25519 {
+
+    constexpr static U<32> value() noexcept {
+        return (U<32>(1U) << 255) - 19U;
+    }
+};
+
+struct Even256 {
+
+    constexpr static U<32> value() noexcept {
+        return ((U<32>(1U) << 255) - 19U) * 2U;
+    }
+};
+
+struct Pow2_100 {
+
+    constexpr static U<16> value() noexcept {
+        return U<16>(1U) << 100;
+    }
+};
+
+struct Odd1024 {
+
+    constexpr static U<128> value() noexcept {
+        return ~U<128>::ZERO() / 3U;
+    }
+};
+
+using NTT = NativeModulus<uint64_t, 998244353ULL>;
+using Small = NativeModulus<uint32_t, 1000000007U>;
+using EvenNative = NativeModulus<uint64_t, 0xfffffffffffffffeULL>;
+
+template<size_t size, typename M>
+static void checkModInt(uint64_t &state) {
+    using I = U<size>;
+    using W = U<size * 2>;
+    using MI = ModInt<size, M>;
+    const I m = MI::modulus();
+    ASSERT_EQ(m, I(M::value()));
+    for (int i = 0; i < 500; i++) {
+        I a = randomValue<I>(state);
+        I b = randomValue<I>(state) % m;
+        MI x(a), y(b);
+        ASSERT_EQ(x.value(), a % m);
+        ASSERT_EQ(y.value(), b);
+        ASSERT_EQ((x * y).value(), I(W(a % m) * W(b) % W(m)));
+        ASSERT_EQ((x + y).value(), I((W(a % m) + W(b)) % W(m)));
+        ASSERT_EQ((x - y).value(), I((W(a % m) + W(m) - W(b)) % W(m)));
+        ASSERT_EQ((-y + y).value(), I::ZERO());
+        MI z = x;
+        z *= y;
+        z += x;
+        z -= y;
+        ASSERT_EQ(z, x * y + x - y);
+        // Fermat or any pow vs. repeated multiplication
+        uint32_t e = uint32_t(next(state) % 50);
+        MI p = MI::ONE();
+        for (uint32_t j = 0; j < e; j++) {
+            p *= x;
+        }
+        ASSERT_EQ(x.pow(e), p);
+        ASSERT_EQ(x.pow(U<4>(e)), p);
+        MI inv = y.inverse();
+        if (!inv.isZero()) {
+            ASSERT_EQ(inv * y, MI::ONE());
+            ASSERT_EQ(y.pow(-3) * y.pow(3), MI::ONE());
+        }
+    }
+}
+
+TEST(ModInt, montgomery) {
+    uint64_t state = 0x4b7a70e9b5b32944ULL;
+    checkModInt<32, P25519>(state);
+    checkModInt<8, NTT>(state);
+    checkModInt<128, Odd1024>(state);
+}
+
+TEST(ModInt, barrett) {
+    uint64_t state = 0xdb75092ec4192623ULL;
+    checkModInt<32, Even256>(state);
+    checkModInt<8, EvenNative>(state);
+}
+
+TEST(ModInt, mask_and_native) {
+    uint64_t state = 0xad6ea6b049a7df7dULL;
+    checkModInt<16, Pow2_100>(state);
+    checkModInt<4, Small>(state);
+}
+
+TEST(ModInt, signed_constructor) {
+    using MI = ModInt<4, Small>;
+    EXPECT_EQ(MI(-1).value(), U<4>(1000000006U));
+    EXPECT_EQ(MI(int64_t(-2000000014)).value(), U<4>::ZERO());
+    EXPECT_EQ(MI(uint64_t(1) << 40).value(), U<4>(uint32_t((1ULL << 40) % 1000000007U)));
+    EXPECT_EQ((ModInt<32, P25519>(-5).value()), P25519::value() - 5U);
+}
+
+TEST(ModInt, montgomery_context) {
+    uint64_t state = 0x0f6d6ff383f44239ULL;
+    const U<32> m = P25519::value();
+    Montgomery<32> ctx(m);
+    for (int i = 0; i < 500; i++) {
+        U<32> a = randomValue<U<32>>(state) % m, b = randomValue<U<32>>(state) % m;
+        U<32> am = ctx.to(a), bm = ctx.to(b);
+        ASSERT_EQ(ctx.from(am), a);
+        ASSERT_EQ(ctx.from(ctx.mul(am, bm)), U<32>(wmultiply(a, b) % U<64>(m)));
+        ASSERT_EQ(ctx.from(ctx.add(am, bm)), U<32>((U<64>(a) + b) % U<64>(m)));
+        ASSERT_EQ(ctx.from(ctx.sub(am, bm)), U<32>((U<64>(a) + m - b) % U<64>(m)));
+    }
+    // a^(p - 1) = 1
+    EXPECT_EQ(ctx.from(ctx.pow(ctx.to(U<32>(2U)), m - 1U)), U<32>(1U));
+}
+
+TEST(ModInt, constexpr_modint) {
+    using MI = ModInt<8, NTT>;
+    constexpr MI a = MI(3U);
+    static_assert(a.pow(998244352U) == MI::ONE(), "");
+    static_assert((a * a.inverse()).value() == 1U, "");
+    static_assert((MI(998244352U) + MI(2U)).value() == 1U, "");
+    constexpr ModInt<32, P25519> b = ModInt<32, P25519>(2U);
+    static_assert((b.pow(255) - ModInt<32, P25519>(19U)).isZero(), "");
+}
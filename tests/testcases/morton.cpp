@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+#include <vector>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+template<size_t D, typename T, typename R>
+static R refEncode(const T (&c)[D]) {
+    R out = R::ZERO();
+    for (size_t i = 0; i < sizeof (T) * 8; i++) {
+        for (size_t j = 0; j < D; j++) {
+            out.setBit(i * D + j, (c[j] >> i) & 1);
+        }
+    }
+    return out;
+}
+
+TEST(Morton, return_type) {
+    ASSERT_EQ_TYPE(U<2>, decltype(mortonEncode<2>(uint8_t(1), uint8_t(2))));
+    ASSERT_EQ_TYPE(U<16>, decltype(mortonEncode<3>(1U, 2U, 3U)));
+    ASSERT_EQ_TYPE(U<16>, decltype(mortonEncode<4>(1U, 2U, 3U, 4U)));
+    ASSERT_EQ_TYPE(U<32>, decltype(mortonEncode<3>(1ULL, 2ULL, 3ULL)));
+    ASSERT_EQ_TYPE(U<32>, decltype(mortonEncode<4>(1ULL, 2ULL, 3ULL, 4ULL)));
+}
+
+TEST(Morton, small) {
+    EXPECT_EQ(mortonEncode<2>(uint8_t(0xff), uint8_t(0)), U<2>(0x5555));
+    EXPECT_EQ(mortonEncode<2>(uint8_t(0), uint8_t(0xff)), U<2>(0xaaaa));
+    EXPECT_EQ(mortonEncode<3>(1U, 0U, 1U), U<16>(5));
+    EXPECT_EQ(mortonEncode<3>(0U, 0U, 0x80000000U), U<16>(1) << 95);
+}
+
+template<size_t D, typename T>
+static void checkRoundTrip3(uint64_t seed) {
+    using R = decltype(mortonEncode<D>(T(0), T(0), T(0)));
+    for (int iter = 0; iter < 200; iter++) {
+        T c[D];
+        for (auto &x : c) {
+            x = T(next(seed));
+        }
+        R key = mortonEncode<D>(c[0], c[1], c[2]);
+        ASSERT_EQ(key, (refEncode<D, T, R>(c)));
+        T out[D];
+        mortonDecode<D>(key, out);
+        for (size_t j = 0; j < D; j++) {
+            ASSERT_EQ(out[j], c[j]);
+        }
+    }
+}
+
+template<size_t D, typename T>
+static void checkRoundTrip4(uint64_t seed) {
+    using R = decltype(mortonEncode<D>(T(0), T(0), T(0), T(0)));
+    for (int iter = 0; iter < 200; iter++) {
+        T c[D];
+        for (auto &x : c) {
+            x = T(next(seed));
+        }
+        R key = mortonEncode<D>(c[0], c[1], c[2], c[3]);
+        ASSERT_EQ(key, (refEncode<D, T, R>(c)));
+        T out[D];
+        mortonDecode<D>(key, out);
+        for (size_t j = 0; j < D; j++) {
+            ASSERT_EQ(out[j], c[j]);
+        }
+    }
+}
+
+TEST(Morton, round_trip) {
+    checkRoundTrip3<3, uint32_t>(1);
+    checkRoundTrip3<3, uint64_t>(2);
+    checkRoundTrip3<3, uint16_t>(3);
+    checkRoundTrip4<4, uint32_t>(4);
+    checkRoundTrip4<4, uint64_t>(5);
+}
+
+TEST(Morton, batch) {
+    uint64_t seed = 6;
+    constexpr size_t n = 100;
+    std::vector<uint32_t> points(n * 3);
+    for (auto &x : points) {
+        x = uint32_t(next(seed));
+    }
+    std::vector<U<16>> keys(n);
+    mortonEncode<3>(points.data(), n, keys.data());
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(keys[i], mortonEncode<3>(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]));
+    }
+    std::vector<uint32_t> decoded(n * 3);
+    mortonDecode<3>(keys.data(), n, decoded.data());
+    EXPECT_EQ(decoded, points);
+}
+
+TEST(Morton, constexpr_morton) {
+    constexpr U<16> key = mortonEncode<3>(7U, 0U, 0xffffffffU);
+    static_assert(key.getBit(0) && key.getBit(3) && key.getBit(6) && !key.getBit(9), "constexpr encode");
+    static_assert(key.getBit(2) && key.getBit(95), "constexpr encode");
+    EXPECT_EQ(key, mortonEncode<3>(7U, 0U, 0xffffffffU));
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+
+using namespace JIO;
+
+template<size_t size, size_t size2>
+static void checkProduct(size_t n, uint64_t &state) {
+    using I = U<size>;
+    using E = U<size2>;
+    const I m = randomValue<I>(state) | 1U;
+    Montgomery<size> ctx(m);
+    std::vector<I> bases;
+    std::vector<E> exps;
+    I expected = ctx.one();
+    for (size_t i = 0; i < n; i++) {
+        bases.push_back(randomValue<I>(state));
+        // different lengths and zero exponents
+        exps.push_back(next(state) % 8 == 0 ? E::ZERO() :
+                randomValue<E>(state) >> (next(state) % (size2 * 8)));
+        expected = ctx.mul(expected, ctx.pow(ctx.to(bases[i]), exps[i]));
+    }
+    ASSERT_EQ(multi_powmod(bases.data(), exps.data(), n, m), ctx.from(expected)) << n;
+}
+
+TEST(MultiPow, straus) {
+    uint64_t state = 0x9b05688c2b3e6c1fULL;
+    for (size_t n = 0; n <= 16; n++) {
+        checkProduct<8, 8>(n, state);
+        checkProduct<32, 32>(n, state);
+    }
+    checkProduct<8, 32>(5, state);
+    checkProduct<32, 4>(7, state);
+}
+
+TEST(MultiPow, pippenger) {
+    uint64_t state = 0x1f83d9abfb41bd6bULL;
+    checkProduct<8, 8>(17, state);
+    checkProduct<8, 8>(128, state);
+    checkProduct<8, 8>(129, state);
+    checkProduct<32, 32>(100, state);
+    checkProduct<32, 32>(300, state);
+    checkProduct<8, 16>(1000, state);
+    checkProduct<16, 64>(40, state);
+}
+
+TEST(MultiPow, wide_values) {
+    // the tables of 256 byte values are too large for the stack
+    uint64_t state = 0xcbbb9d5dc1059ed8ULL;
+    checkProduct<256, 8>(10, state);
+    checkProduct<256, 4>(40, state);
+}
+
+TEST(MultiPow, known_values) {
+    const U<8> m(1000000007U);
+    const U<8> bases[] = {U<8>(2U), U<8>(3U), U<8>(5U)};
+    const U<8> exps[] = {U<8>(10U), U<8>(4U), U<8>(1000000006U)};
+    EXPECT_EQ(multi_powmod(bases, exps, 3, m), U<8>(1024U * 81U));
+    EXPECT_EQ(multi_powmod(bases, exps, 0, m), U<8>(1U));
+    const U<8> cb[] = {U<8>(7U), U<8>(11U)};
+    const U<2> ce[] = {U<2>(3U), U<2>(2U)};
+    EXPECT_EQ(multi_powmod(cb, ce, 2, U<8>(1000003U)), U<8>(343U * 121U));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+TEST(Multiply, wmultiply_native) {
+    U<16> r = wmultiply(U<8>(~0ULL), U<8>(~0ULL));
+    EXPECT_EQ(r, U<16>(1ULL, 0xfffffffffffffffeULL));
+    EXPECT_EQ(wmultiply(U<8>(0x100000000ULL), U<8>(0x100000000ULL)), U<16>(0ULL, 1ULL));
+    EXPECT_EQ(wmultiply(U<4>(0xffffffffU), U<4>(2U)), U<8>(0x1fffffffeULL));
+}
+
+TEST(Multiply, square_return_type) {
+    ASSERT_EQ_TYPE(U<2>, decltype(wsquare(U<1>(1))));
+    ASSERT_EQ_TYPE(U<16>, decltype(wsquare(U<8>(1))));
+    ASSERT_EQ_TYPE(U<64>, decltype(wsquare(U<32>(1))));
+    ASSERT_EQ_TYPE(S<16>, decltype(sqr(S<16>(1))));
+    ASSERT_EQ_TYPE(U<32>, decltype(sqr(U<32>(1))));
+}
+
+template<typename I>
+static void checkSquare(uint64_t seed) {
+    using UI = Integer<sizeof (I), false>;
+    for (int iter = 0; iter < 200; iter++) {
+        I v = randomMixed<I>(seed);
+        ASSERT_EQ(wsquare(UI(v)), wmultiply(UI(v), UI(v)));
+        ASSERT_EQ(sqr(v), v * v);
+    }
+    I max = ~I::ZERO();
+    ASSERT_EQ(wsquare(UI(max)), wmultiply(UI(max), UI(max)));
+    ASSERT_EQ(sqr(max), max * max);
+}
+
+TEST(Multiply, square) {
+    checkSquare<U<1>>(1);
+    checkSquare<U<4>>(2);
+    checkSquare<U<8>>(3);
+    checkSquare<U<16>>(4);
+    checkSquare<S<16>>(5);
+    checkSquare<U<32>>(6);
+    checkSquare<U<64>>(7);
+    checkSquare<S<128>>(8);
+}
+
+template<typename I>
+static I refMultiply(I a, I b) {
+    // shift and add, independent of the multiply kernels
+    I out = I::ZERO();
+    for (size_t i = 0; i < sizeof (I) * 8; i++) {
+        if (b.getBit(i)) {
+            out = out + (a << i);
+        }
+    }
+    return out;
+}
+
+template<size_t size>
+static void checkSparse(uint64_t &state) {
+    for (int iter = 0; iter < 200; iter++) {
+        // operands with a random effective length
+        U<size> a = randomMixed<U<size>>(state) >> (next(state) % (size * 8));
+        U<size> b = randomMixed<U<size>>(state) >> (next(state) % (size * 8));
+        ASSERT_EQ(a * b, refMultiply(a, b));
+        U<size * 2> w = wmultiply(a, b);
+        ASSERT_EQ(w, refMultiply(U<size * 2>(a), U<size * 2>(b)));
+        ASSERT_EQ(wsquare(a), refMultiply(U<size * 2>(a), U<size * 2>(a)));
+        if (!b.isZero()) {
+            U<size> r = U<size>::ZERO();
+            U<size> q = divrem(a, b, &r);
+            ASSERT_LT(r, b);
+            ASSERT_EQ(q * b + r, a);
+        }
+    }
+}
+
+TEST(Multiply, sparse_operands) {
+    uint64_t state = 0x3f84d5b5b5470917ULL;
+    checkSparse<16>(state);
+    checkSparse<32>(state);
+    checkSparse<64>(state);
+}
+
+TEST(Multiply, constexpr_square) {
+    constexpr U<16> v = U<16>(~0ULL, ~0ULL);
+    constexpr U<32> w = wsquare(v);
+    // (2^128 - 1)^2 = 2^256 - 2^129 + 1
+    static_assert(w == U<32>(U<16>(1), U<16>(~1ULL, ~0ULL)), "constexpr wsquare");
+    static_assert(sqr(S<16>(-3)) == 9, "constexpr sqr");
+    EXPECT_EQ(w, wmultiply(v, v));
+}
+
+TEST(Multiply, signed_return_type) {
+    ASSERT_EQ_TYPE(S<2>, decltype(wmultiply(S<1>(1), S<1>(1))));
+    ASSERT_EQ_TYPE(S<16>, decltype(wmultiply(S<8>(1), S<8>(1))));
+    ASSERT_EQ_TYPE(S<64>, decltype(wmultiply(S<32>(1), S<32>(1))));
+    ASSERT_EQ_TYPE(S<32>, decltype(wsquare(S<16>(1))));
+    ASSERT_EQ_TYPE(S<16>, decltype(mulhi(S<16>(1), S<16>(1))));
+    ASSERT_EQ_TYPE(U<8>, decltype(mulhi(U<8>(1), U<8>(1))));
+}
+
+template<typename I>
+static void checkWideMultiply(uint64_t seed) {
+    using W = Integer<sizeof (I) * 2, I::is_signed()>;
+    constexpr size_t bits = sizeof (I) * 8;
+    I special[] = {I::ZERO(), I::ONE(), ~I::ZERO(), I::MIN_VALUE(), I::MAX_VALUE()};
+    for (int iter = 0; iter < 300; iter++) {
+        I a = iter < 25 ? special[iter % 5] : randomMixed<I>(seed);
+        I b = iter < 25 ? special[iter / 5] : randomMixed<I>(seed);
+        if (next(seed) % 2) {
+            a = -a;
+        }
+        W ref = W(a) * W(b);
+        ASSERT_EQ(wmultiply(a, b), ref);
+        ASSERT_EQ(mulhi(a, b), I(ref >> bits));
+        ASSERT_EQ(wsquare(a), W(a) * W(a));
+    }
+}
+
+TEST(Multiply, signed_wide) {
+    checkWideMultiply<S<1>>(11);
+    checkWideMultiply<S<4>>(12);
+    checkWideMultiply<S<8>>(13);
+    checkWideMultiply<S<16>>(14);
+    checkWideMultiply<S<32>>(15);
+    checkWideMultiply<S<64>>(16);
+}
+
+TEST(Multiply, mulhi_unsigned) {
+    checkWideMultiply<U<2>>(21);
+    checkWideMultiply<U<8>>(22);
+    checkWideMultiply<U<16>>(23);
+    checkWideMultiply<U<32>>(24);
+    checkWideMultiply<U<64>>(25);
+}
+
+TEST(Multiply, constexpr_signed) {
+    constexpr S<32> w = wmultiply(S<16>(-1), S<16>(-1));
+    static_assert(w == 1, "constexpr signed wmultiply");
+    static_assert(mulhi(S<16>(-1), S<16>(1)) == -1, "constexpr signed mulhi");
+    static_assert(mulhi(U<16>(~0ULL, ~0ULL), U<16>(2)) == 1, "constexpr mulhi");
+    EXPECT_EQ(w, 1);
+}
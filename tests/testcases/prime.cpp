@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+
+using namespace JIO;
+
+static U<8> mulmod(const U<8> &a, const U<8> &b, const U<8> &m) {
+    return U<8>(wmultiply(a, b) % U<16>(m));
+}
+
+// plain strong probable prime test with the first 12 primes,
+// deterministic below 2^64
+static bool reference(uint64_t n) {
+    if (n < 2) {
+        return false;
+    }
+    const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (uint64_t p : bases) {
+        if (n % p == 0) {
+            return n == p;
+        }
+    }
+    uint64_t d = n - 1;
+    size_t s = 0;
+    for (; d % 2 == 0; s++) {
+        d /= 2;
+    }
+    const U<8> m(n);
+    for (uint64_t a : bases) {
+        U<8> x(1U), b(a);
+        for (uint64_t e = d; e != 0; e /= 2) {
+            if (e & 1) {
+                x = mulmod(x, b, m);
+            }
+            b = mulmod(b, b, m);
+        }
+        bool probable = x == 1U || x == n - 1;
+        for (size_t i = 1; i < s && !probable; i++) {
+            x = mulmod(x, x, m);
+            probable = x == n - 1;
+        }
+        if (!probable) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(Prime, sieve) {
+    std::vector<bool> composite(100000);
+    for (size_t i = 2; i < composite.size(); i++) {
+        ASSERT_EQ(is_prime(U<8>(i)), !composite[i]) << i;
+        ASSERT_EQ(is_prime(U<4>(i)), !composite[i]) << i;
+        for (size_t j = i * i; j < composite.size(); j += i) {
+            composite[j] = true;
+        }
+    }
+    EXPECT_FALSE(is_prime(U<1>(0U)));
+    EXPECT_FALSE(is_prime(U<1>(1U)));
+    EXPECT_TRUE(is_prime(U<1>(251U)));
+    EXPECT_FALSE(is_prime(U<2>(65535U)));
+    EXPECT_TRUE(is_prime(U<2>(65521U)));
+}
+
+TEST(Prime, random_64) {
+    uint64_t state = 0x8a5cd789635d2dffULL;
+    for (int i = 0; i < 5000; i++) {
+        uint64_t n = next(state) >> (next(state) % 48) | 1;
+        ASSERT_EQ(is_prime(U<8>(n)), reference(n)) << n;
+        ASSERT_EQ(is_prime(U<32>(n)), reference(n)) << n;
+    }
+}
+
+TEST(Prime, pseudoprimes) {
+    // Carmichael numbers and strong pseudoprimes to several bases
+    EXPECT_FALSE(is_prime(U<8>(561U)));
+    EXPECT_FALSE(is_prime(U<8>(3215031751ULL)));
+    EXPECT_FALSE(is_prime(U<8>(3825123056546413051ULL)));
+    // strong pseudoprimes to the primes up to 37 and up to 41
+    EXPECT_FALSE(is_prime(U<16>(0x437aULL) << 64 | U<16>(0xe92817f9fc85b7e5ULL)));
+    EXPECT_FALSE(is_prime(U<16>(0x2be69ULL) << 64 | U<16>(0x51adc5b22410a5fdULL)));
+    // strong Lucas pseudoprimes, spsp to base 2 and squares
+    EXPECT_FALSE(is_prime(U<8>(5459U)));
+    EXPECT_FALSE(is_prime(U<8>(5777U)));
+    EXPECT_FALSE(is_prime(U<16>(3825123056546413051ULL) * U<16>(1000000007U)));
+    const U<32> m61 = (U<32>(1U) << 61) - 1U;
+    const U<32> m89 = (U<32>(1U) << 89) - 1U;
+    EXPECT_FALSE(is_prime(m61 * m61));
+    EXPECT_FALSE(is_prime(m61 * m89));
+    EXPECT_FALSE(is_prime(m89 * m89));
+    EXPECT_FALSE(is_prime((U<16>(1U) << 67) - 1U));
+}
+
+TEST(Prime, known_primes) {
+    EXPECT_TRUE(is_prime(U<8>((1ULL << 61) - 1)));
+    EXPECT_TRUE(is_prime(U<8>(18446744073709551557ULL)));
+    EXPECT_TRUE(is_prime((U<16>(1U) << 89) - 1U));
+    EXPECT_TRUE(is_prime((U<16>(1U) << 127) - 1U));
+    EXPECT_TRUE(is_prime((U<32>(1U) << 255) - 19U));
+    EXPECT_TRUE(is_prime(U<32>::ZERO() - (U<32>(1U) << 32) - 977U));
+    EXPECT_TRUE(is_prime((U<128>(1U) << 521) - 1U));
+    EXPECT_FALSE(is_prime((U<128>(1U) << 523) - 1U));
+}
+
+TEST(Prime, constexpr_prime) {
+    static_assert(is_prime(U<8>(1000000007U)), "");
+    static_assert(!is_prime(U<8>(1000000007ULL * 998244353ULL)), "");
+    static_assert(is_prime(U<2>(65521U)), "");
+}
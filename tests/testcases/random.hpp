@@ -0,0 +1,48 @@
+#ifndef TESTCASES_RANDOM_HPP
+#define TESTCASES_RANDOM_HPP
+
+#include <Integer.hpp>
+#include <cstdint>
+
+template<size_t size>
+using U = JIO::Integer<size, false>;
+template<size_t size>
+using S = JIO::Integer<size, true>;
+
+inline uint64_t next(uint64_t &state) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// the low bytes of v are random, the others zero
+template<typename I>
+inline I randomBytes(uint64_t &state, size_t bytes) {
+    I v = I::ZERO();
+    for (size_t i = 0; i < bytes; i++) {
+        v.setByte(i, next(state));
+    }
+    return v;
+}
+
+template<typename I>
+inline I randomValue(uint64_t &state) {
+    return randomBytes<I>(state, sizeof (I));
+}
+
+// any length from one byte to the full width
+template<typename I>
+inline I randomLength(uint64_t &state) {
+    return randomBytes<I>(state, next(state) % sizeof (I) + 1);
+}
+
+// mostly full width, a third of the values are shorter
+template<typename I>
+inline I randomMixed(uint64_t &state) {
+    return randomBytes<I>(state, next(state) % 3 == 0 ?
+            next(state) % sizeof (I) + 1 : sizeof (I));
+}
+
+#endif /* TESTCASES_RANDOM_HPP */
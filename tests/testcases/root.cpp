@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+#define ASSERT_EQ_TYPE(T1, T2) \
+ASSERT_TRUE((std::is_same<T1, T2>()))
+
+template<size_t k, typename W>
+static W power(const W &r) {
+    W out = W(1U);
+    for (size_t i = 0; i < k; i++) {
+        out *= r;
+    }
+    return out;
+}
+
+template<size_t k, size_t size>
+static void checkRoot(const U<size> &x) {
+    using W = U<size * 2>;
+    U<size> r = iroot<k>(x);
+    ASSERT_LE(power<k>(W(r)), W(x)) << x;
+    ASSERT_GT(power<k>(W(r) + 1U), W(x)) << x;
+}
+
+template<size_t size>
+static void checkSqrt(uint64_t &state) {
+    using W = U<size * 2>;
+    for (int i = 0; i < 300; i++) {
+        U<size> x = randomLength<U<size>>(state);
+        U<size> rem = U<size>::ZERO();
+        U<size> r = isqrt_rem(x, &rem);
+        ASSERT_EQ(isqrt(x), r);
+        ASSERT_EQ(W(r) * W(r) + W(rem), W(x)) << x;
+        ASSERT_LE(rem, r * 2U) << x;
+        // squares and their neighbours
+        U<size> y = r * r;
+        ASSERT_EQ(isqrt(y), r);
+        if (!y.isZero()) {
+            ASSERT_EQ(isqrt(U<size>(y - 1U)), r - 1U);
+        }
+        checkRoot<3>(x);
+        checkRoot<5>(x);
+    }
+}
+
+TEST(Root, return_type) {
+    U<32> rem;
+    ASSERT_EQ_TYPE(decltype(isqrt(U<32>())), U<32>);
+    ASSERT_EQ_TYPE(decltype(isqrt_rem(U<32>(), &rem)), U<32>);
+    ASSERT_EQ_TYPE(decltype(iroot<3>(U<8>())), U<8>);
+}
+
+TEST(Root, sqrt) {
+    uint64_t state = 0x9c30d5392af26013ULL;
+    checkSqrt<1>(state);
+    checkSqrt<4>(state);
+    checkSqrt<8>(state);
+    checkSqrt<16>(state);
+    checkSqrt<32>(state);
+    checkSqrt<64>(state);
+    checkSqrt<128>(state);
+}
+
+TEST(Root, kth_root) {
+    uint64_t state = 0xc5d1b023286085f0ULL;
+    for (int i = 0; i < 300; i++) {
+        U<32> x = randomLength<U<32>>(state);
+        checkRoot<2>(x);
+        checkRoot<4>(x);
+        checkRoot<7>(x);
+        checkRoot<64>(x);
+        checkRoot<255>(x);
+        checkRoot<300>(x);
+        U<128> y = randomLength<U<128>>(state);
+        checkRoot<3>(y);
+        checkRoot<17>(y);
+    }
+}
+
+TEST(Root, edge_cases) {
+    EXPECT_EQ(isqrt(U<32>::ZERO()), U<32>::ZERO());
+    EXPECT_EQ(isqrt(U<32>(1U)), U<32>(1U));
+    EXPECT_EQ(isqrt(U<32>(3U)), U<32>(1U));
+    EXPECT_EQ(isqrt(U<32>(4U)), U<32>(2U));
+    EXPECT_EQ(isqrt(~U<32>::ZERO()), ~U<32>::ZERO() >> 128);
+    EXPECT_EQ(isqrt(~U<8>::ZERO()), U<8>(0xffffffffULL));
+    EXPECT_EQ(isqrt(U<8>(0xfffffffe00000001ULL)), U<8>(0xffffffffULL));
+    EXPECT_EQ(isqrt(U<8>(0xfffffffe00000000ULL)), U<8>(0xfffffffeULL));
+    U<64> p = U<64>(3U) << 200;
+    U<64> rem = U<64>::ZERO();
+    EXPECT_EQ(isqrt_rem(p * p, &rem), p);
+    EXPECT_EQ(rem, U<64>::ZERO());
+    EXPECT_EQ(isqrt_rem(p * p - 1U, &rem), p - 1U);
+    EXPECT_EQ(rem, p * 2U - 2U);
+    EXPECT_EQ(iroot<3>(U<16>(1000000U)), U<16>(100U));
+    EXPECT_EQ(iroot<3>(U<16>(999999U)), U<16>(99U));
+    EXPECT_EQ(iroot<200>(~U<16>::ZERO()), U<16>(1U));
+    EXPECT_EQ(iroot<127>(~U<16>::ZERO()), U<16>(2U));
+    EXPECT_EQ(iroot<128>(~U<16>::ZERO()), U<16>(1U));
+    EXPECT_EQ(iroot<3>(U<1>(255U)), U<1>(6U));
+}
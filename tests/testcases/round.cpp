@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<typename I>
+static I randomShort(uint64_t &state) {
+    return randomValue<I>(state) >> (next(state) % (sizeof (I) * 8));
+}
+
+template<typename I>
+static I randomDivisor(uint64_t &state) {
+    I d = next(state) % 4 == 0 ? I(1) << (next(state) % (sizeof (I) * 8 - 1)) :
+            randomShort<I>(state);
+    d = d.isZero() ? I(1) : d;
+    return next(state) & 1 ? -d : d;
+}
+
+// the truncated quotient and remainder, moved by one if needed
+template<typename I>
+static void reference(const I &x, const I &y, I &floor, I &ceil, I &euclid) {
+    I r = x % y;
+    I q = x / y;
+    floor = q;
+    ceil = q;
+    euclid = q;
+    if (!r.isZero()) {
+        if (r.isNegative() != y.isNegative()) {
+            floor = q - I(1);
+        } else {
+            ceil = q + I(1);
+        }
+        if (r.isNegative()) {
+            euclid = y.isNegative() ? q + I(1) : q - I(1);
+        }
+    }
+}
+
+template<typename I>
+static void checkRound(uint64_t &state) {
+    for (int i = 0; i < 2000; i++) {
+        I x = randomShort<I>(state);
+        x = next(state) & 1 ? -x : x;
+        I y = randomDivisor<I>(state);
+        I floor = I(0), ceil = I(0), euclid = I(0);
+        reference(x, y, floor, ceil, euclid);
+        I r = I(0);
+        ASSERT_EQ(div_floor(x, y, &r), floor);
+        ASSERT_EQ(r, x - floor * y);
+        ASSERT_EQ(mod_floor(x, y), r);
+        ASSERT_EQ(div_ceil(x, y, &r), ceil);
+        ASSERT_EQ(r, x - ceil * y);
+        ASSERT_EQ(mod_ceil(x, y), r);
+        ASSERT_EQ(div_euclid(x, y, &r), euclid);
+        ASSERT_EQ(r, x - euclid * y);
+        ASSERT_EQ(mod_euclid(x, y), r);
+        ASSERT_FALSE(r.isNegative());
+    }
+}
+
+TEST(Round, signed_values) {
+    uint64_t state = 0x6a09e667f3bcc908ULL;
+    checkRound<S<1>>(state);
+    checkRound<S<4>>(state);
+    checkRound<S<8>>(state);
+    checkRound<S<16>>(state);
+    checkRound<S<32>>(state);
+    checkRound<S<64>>(state);
+}
+
+TEST(Round, unsigned_values) {
+    uint64_t state = 0xbb67ae8584caa73bULL;
+    for (int i = 0; i < 1000; i++) {
+        U<32> x = randomShort<U<32>>(state);
+        U<32> y = randomShort<U<32>>(state) + 1U;
+        U<32> r = U<32>::ZERO();
+        ASSERT_EQ(div_floor(x, y), x / y);
+        ASSERT_EQ(div_euclid(x, y, &r), x / y);
+        ASSERT_EQ(r, x % y);
+        U<32> c = div_ceil(x, y, &r);
+        ASSERT_EQ(c, (x % y).isZero() ? x / y : x / y + 1U);
+        ASSERT_EQ(c * y + r, x);
+    }
+}
+
+TEST(Round, edge_cases) {
+    EXPECT_EQ(div_floor(S<16>(-7), S<16>(2)), S<16>(-4));
+    EXPECT_EQ(mod_floor(S<16>(-7), S<16>(2)), S<16>(1));
+    EXPECT_EQ(div_floor(S<16>(7), S<16>(-2)), S<16>(-4));
+    EXPECT_EQ(mod_floor(S<16>(7), S<16>(-2)), S<16>(-1));
+    EXPECT_EQ(div_ceil(S<16>(7), S<16>(2)), S<16>(4));
+    EXPECT_EQ(mod_ceil(S<16>(7), S<16>(2)), S<16>(-1));
+    EXPECT_EQ(div_ceil(S<16>(-7), S<16>(-2)), S<16>(4));
+    EXPECT_EQ(mod_ceil(S<16>(-7), S<16>(-2)), S<16>(1));
+    EXPECT_EQ(div_euclid(S<16>(-7), S<16>(-2)), S<16>(4));
+    EXPECT_EQ(mod_euclid(S<16>(-7), S<16>(-2)), S<16>(1));
+    EXPECT_EQ(div_euclid(S<16>(-8), S<16>(2)), S<16>(-4));
+    EXPECT_EQ(mod_euclid(S<16>(-8), S<16>(2)), S<16>(0));
+    // the smallest value by powers of two
+    const S<32> min = S<32>(U<32>(1U) << 255);
+    EXPECT_EQ(div_floor(min, S<32>(1)), min);
+    EXPECT_EQ(div_ceil(min + 1, S<32>(4)), -S<32>(U<32>(1U) << 253) + 1);
+    EXPECT_EQ(div_ceil(~min, S<32>(2)), S<32>(U<32>(1U) << 254));
+    EXPECT_EQ(div_floor(min, S<32>(-1)), min);
+}
+
+template<size_t size>
+static void checkTruncPow2(uint64_t &state) {
+    for (int i = 0; i < 1000; i++) {
+        S<size> x = randomShort<S<size>>(state);
+        x = next(state) & 1 ? -x : x;
+        const size_t s = next(state) % (size * 8 - 1);
+        const S<size> y = S<size>(1) << s;
+        // the magnitude divided as unsigned, then signed back
+        const U<size> ux = x.isNegative() ? U<size>(-x) : U<size>(x);
+        const S<size> uq = S<size>(ux >> s);
+        const S<size> ur = S<size>(ux & (U<size>(y) - 1U));
+        ASSERT_EQ(x / y, x.isNegative() ? -uq : uq);
+        ASSERT_EQ(x % y, x.isNegative() ? -ur : ur);
+    }
+}
+
+TEST(Round, trunc_powers_of_two) {
+    uint64_t state = 0x3c6ef372fe94f82bULL;
+    checkTruncPow2<16>(state);
+    checkTruncPow2<64>(state);
+    EXPECT_EQ(S<16>(-7) / S<16>(2), S<16>(-3));
+    EXPECT_EQ(S<16>(-7) % S<16>(2), S<16>(-1));
+    EXPECT_EQ(S<16>(-8) / S<16>(4), S<16>(-2));
+    const S<32> min = S<32>(U<32>(1U) << 255);
+    EXPECT_EQ((min + 1) / S<32>(2), -S<32>(U<32>(1U) << 254) + 1);
+}
+
+TEST(Round, constexpr_round) {
+    static_assert(div_floor(S<32>(-7), S<32>(2)) == S<32>(-4), "");
+    static_assert(mod_euclid(S<32>(-7), S<32>(-3)) == S<32>(2), "");
+    static_assert(div_ceil(S<32>(-7), S<32>(-3)) == S<32>(3), "");
+    static_assert(mod_floor(S<2>(-7), S<2>(3)) == S<2>(2), "");
+    static_assert(S<32>(-7) / S<32>(4) == S<32>(-1), "");
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <Integer.hpp>
+#include "random.hpp"
+#include <type_traits>
+#include <cstdint>
+
+using namespace JIO;
+
+template<bool sig>
+static void toWords(const Integer<8, sig> &v, uint64_t *w) {
+    *w = v.uvalue();
+}
+
+template<size_t size, bool sig>
+static void toWords(const Integer<size, sig> &v, uint64_t *w) {
+    toWords(v.ulow(), w);
+    toWords(v.uhigh(), w + size / 16);
+}
+
+template<bool sig>
+static void fromWords(Integer<8, sig> &v, const uint64_t *w) {
+    v.uvalue() = *w;
+}
+
+template<size_t size, bool sig>
+static void fromWords(Integer<size, sig> &v, const uint64_t *w) {
+    fromWords(v.ulow(), w);
+    fromWords(v.uhigh(), w + size / 16);
+}
+
+template<typename I>
+static I random(uint64_t &state) {
+    uint64_t w[sizeof (I) / 8];
+    for (auto &x : w) {
+        x = next(state);
+    }
+    I out = I::ZERO();
+    fromWords(out, w);
+    return out;
+}
+
+template<typename I>
+static I refShl(const I &v, size_t shift) {
+    constexpr size_t n = sizeof (I) / 8;
+    uint64_t in[n], out[n] = {};
+    toWords(v, in);
+    for (size_t i = shift; i < n * 64; i++) {
+        uint64_t b = (in[(i - shift) / 64] >> ((i - shift) % 64)) & 1;
+        out[i / 64] |= b << (i % 64);
+    }
+    I r = I::ZERO();
+    fromWords(r, out);
+    return r;
+}
+
+template<typename I>
+static I refShr(const I &v, size_t shift) {
+    constexpr size_t n = sizeof (I) / 8;
+    uint64_t in[n], out[n] = {};
+    toWords(v, in);
+    bool fill = I::is_signed() && (in[n - 1] >> 63);
+    for (size_t i = 0; i < n * 64; i++) {
+        uint64_t b = i + shift < n * 64 ?
+                (in[(i + shift) / 64] >> ((i + shift) % 64)) & 1 : fill;
+        out[i / 64] |= b << (i % 64);
+    }
+    I r = I::ZERO();
+    fromWords(r, out);
+    return r;
+}
+
+template<typename I>
+static void checkShifts(uint64_t seed) {
+    constexpr size_t bits = sizeof (I) * 8;
+    for (int iter = 0; iter < 4; iter++) {
+        I v = random<I>(seed);
+        for (size_t shift = 0; shift < bits; shift++) {
+            ASSERT_EQ(v << shift, refShl(v, shift)) << shift;
+            ASSERT_EQ(v >> shift, refShr(v, shift)) << shift;
+            // distance is taken modulo the bit width
+            ASSERT_EQ(v << (shift + bits), v << shift) << shift;
+            ASSERT_EQ(v >> (shift + bits), v >> shift) << shift;
+        }
+    }
+}
+
+TEST(Shifts, pow2_unsigned) {
+    checkShifts<U<16>>(0x0123456789abcdefULL);
+    checkShifts<U<32>>(0x1111111111111111ULL);
+    checkShifts<U<64>>(0x2222222222222222ULL);
+    checkShifts<U<128>>(0x3333333333333333ULL);
+}
+
+TEST(Shifts, pow2_signed) {
+    checkShifts<S<16>>(0x4444444444444444ULL);
+    checkShifts<S<32>>(0x5555555555555555ULL);
+    checkShifts<S<64>>(0x6666666666666666ULL);
+    checkShifts<S<128>>(0x7777777777777777ULL);
+}
+
+TEST(Shifts, arithmetic_right) {
+    S<16> v = -S<16>(5);
+    EXPECT_EQ(v >> 1, -S<16>(3));
+    EXPECT_EQ(v >> 64, -S<16>(1));
+    EXPECT_EQ(v >> 127, -S<16>(1));
+    EXPECT_EQ(U<16>(v) >> 127, U<16>(1));
+}
+
+TEST(Shifts, constexpr_shift) {
+    constexpr U<32> v = U<32>(U<16>(0x8000000000000001ULL, 1ULL), U<16>(0ULL, 0ULL));
+    constexpr U<32> l = v << 65;
+    constexpr U<32> r = l >> 65;
+    static_assert(r == v, "constexpr shift");
+    static_assert(l.ulow().ulow() == 0 && l.ulow().uhigh() == 2 &&
+            l.uhigh().ulow() == 3, "constexpr shift");
+    EXPECT_EQ(r, v);
+}